@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+#include <sge/asset/asset_registry.h>
+#include <sge/asset/json.h>
+#include <sge/core/directory_watcher.h>
+
+namespace sge::bench {
+    static void create_files(const fs::path& directory, size_t count) {
+        // a few levels of nesting, like a real asset directory
+        for (size_t i = 0; i < count; i++) {
+            fs::path subdirectory = directory / ("dir" + std::to_string(i % 16));
+            fs::create_directories(subdirectory);
+
+            std::ofstream stream(subdirectory / ("file" + std::to_string(i) + ".txt"));
+            stream << i << std::flush;
+        }
+    }
+
+    SGE_BENCHMARK(asset_registry_load) {
+        size_t count = context.get_count();
+        fs::path directory = create_temp_directory("asset_registry_load");
+        create_files(directory, count);
+
+        // paths are absolute, so that no project has to be loaded
+        json data = json::array();
+        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            json node;
+            node["guid"] = guid();
+            node["path"] = entry.path();
+            node["type"] = "texture_2d";
+
+            data.push_back(node);
+        }
+
+        fs::path registry_path = directory / "registry.json";
+        {
+            std::ofstream stream(registry_path);
+            stream << data.dump(4) << std::flush;
+        }
+
+        project::init();
+
+        asset_registry registry(registry_path);
+        context.measure("asset_registry::load", [&]() { registry.load(); });
+
+        project::shutdown();
+        fs::remove_all(directory);
+    }
+
+    SGE_BENCHMARK(directory_watcher_scan) {
+        fs::path directory = create_temp_directory("directory_watcher_scan");
+        create_files(directory, context.get_count());
+
+        directory_watcher watcher(directory);
+        context.measure("directory_watcher::update (no changes)", [&]() { watcher.update(); });
+
+        fs::remove_all(directory);
+    }
+} // namespace sge::bench
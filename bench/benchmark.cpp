@@ -0,0 +1,203 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+#include <sge/asset/json.h>
+#include <iostream>
+#include <iomanip>
+
+namespace sge::bench {
+    struct registered_benchmark {
+        std::string name;
+        benchmark_callback callback;
+    };
+
+    static std::vector<registered_benchmark>& get_benchmarks() {
+        static std::vector<registered_benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    benchmark_registrar::benchmark_registrar(const std::string& name,
+                                             const benchmark_callback& callback) {
+        get_benchmarks().push_back({ name, callback });
+    }
+
+    void benchmark_context::measure(const std::string& name, const std::function<void()>& body,
+                                    const std::function<void()>& setup) {
+        using namespace std::chrono;
+
+        benchmark_result result;
+        result.name = name;
+        result.count = m_count;
+        result.iterations = m_iterations;
+        result.min_ms = std::numeric_limits<double>::max();
+        result.max_ms = 0.0;
+
+        double total_ms = 0.0;
+        for (size_t i = 0; i < m_iterations; i++) {
+            if (setup) {
+                setup();
+            }
+
+            auto t0 = high_resolution_clock::now();
+            body();
+            auto t1 = high_resolution_clock::now();
+
+            double ms = duration_cast<duration<double, std::milli>>(t1 - t0).count();
+            result.min_ms = std::min(result.min_ms, ms);
+            result.max_ms = std::max(result.max_ms, ms);
+            total_ms += ms;
+        }
+
+        result.mean_ms = m_iterations > 0 ? total_ms / (double)m_iterations : 0.0;
+        m_results.push_back(result);
+    }
+
+    fs::path create_temp_directory(const std::string& name) {
+        fs::path directory = fs::temp_directory_path() / "sge_bench" / name;
+        if (fs::exists(directory)) {
+            fs::remove_all(directory);
+        }
+
+        fs::create_directories(directory);
+        return directory;
+    }
+
+    static void write_json(const std::vector<benchmark_result>& results, std::ostream& stream) {
+        json data;
+        data["benchmarks"] = json::array();
+
+        for (const auto& result : results) {
+            json result_data;
+            result_data["name"] = result.name;
+            result_data["count"] = result.count;
+            result_data["iterations"] = result.iterations;
+            result_data["mean_ms"] = result.mean_ms;
+            result_data["min_ms"] = result.min_ms;
+            result_data["max_ms"] = result.max_ms;
+
+            data["benchmarks"].push_back(result_data);
+        }
+
+        stream << data.dump(4) << std::endl;
+    }
+
+    static std::vector<size_t> parse_counts(const std::string& list) {
+        std::vector<size_t> counts;
+
+        std::stringstream stream(list);
+        std::string count;
+        while (std::getline(stream, count, ',')) {
+            if (!count.empty()) {
+                counts.push_back((size_t)std::stoull(count));
+            }
+        }
+
+        return counts;
+    }
+
+    static void print_results(const std::vector<benchmark_result>& results) {
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(10)
+                  << "count" << std::setw(12) << "mean (ms)" << std::setw(12) << "min (ms)"
+                  << std::setw(12) << "max (ms)" << std::endl;
+
+        for (const auto& result : results) {
+            std::cout << std::left << std::setw(48) << result.name << std::right
+                      << std::setw(10) << result.count << std::fixed << std::setprecision(4)
+                      << std::setw(12) << result.mean_ms << std::setw(12) << result.min_ms
+                      << std::setw(12) << result.max_ms << std::endl;
+        }
+    }
+
+    static int32_t run(int32_t argc, const char** argv) {
+        std::vector<size_t> counts = { 100, 1000, 10000 };
+        size_t iterations = 10;
+        std::string filter, json_path;
+
+        for (int32_t i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+
+            if (arg == "--counts" && has_value) {
+                counts = parse_counts(argv[++i]);
+            } else if (arg == "--iterations" && has_value) {
+                iterations = (size_t)std::stoull(argv[++i]);
+            } else if (arg == "--filter" && has_value) {
+                filter = argv[++i];
+            } else if (arg == "--json" && has_value) {
+                json_path = argv[++i];
+            } else {
+                std::cerr << "usage: " << argv[0]
+                          << " [--counts N,N,...] [--iterations N] [--filter NAME] [--json PATH]"
+                          << std::endl;
+
+                return EXIT_FAILURE;
+            }
+        }
+
+        std::vector<benchmark_result> results;
+        for (size_t count : counts) {
+            benchmark_context context(count, iterations, results);
+
+            for (const auto& benchmark : get_benchmarks()) {
+                if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                    continue;
+                }
+
+                benchmark.callback(context);
+            }
+        }
+
+        // "-" writes json in place of the table
+        if (json_path == "-") {
+            write_json(results, std::cout);
+        } else {
+            print_results(results);
+
+            if (!json_path.empty()) {
+                std::ofstream stream(json_path);
+                write_json(results, stream);
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // never initialized. engine code that queries the application, like the script engine,
+    // needs an instance to exist
+    class bench_app : public application {
+    public:
+        bench_app() : application("SGE benchmarks") {}
+    };
+} // namespace sge::bench
+
+application* create_app_instance() { return new sge::bench::bench_app; }
+
+int32_t main(int32_t argc, const char** argv) {
+    sge::application::create();
+
+    int32_t result;
+    try {
+        result = sge::bench::run(argc, argv);
+    } catch (const std::exception& exc) {
+        std::cerr << exc.what() << std::endl;
+        result = EXIT_FAILURE;
+    }
+
+    sge::application::destroy();
+    return result;
+}
@@ -0,0 +1,57 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+namespace sge::bench {
+    struct benchmark_result {
+        std::string name;
+        size_t count, iterations;
+        double mean_ms, min_ms, max_ms;
+    };
+
+    class benchmark_context {
+    public:
+        benchmark_context(size_t count, size_t iterations,
+                          std::vector<benchmark_result>& results)
+            : m_count(count), m_iterations(iterations), m_results(results) {}
+
+        // number of elements each benchmark should process
+        size_t get_count() const { return m_count; }
+
+        // times the body over a number of iterations. setup, if given, runs untimed before each
+        void measure(const std::string& name, const std::function<void()>& body,
+                     const std::function<void()>& setup = nullptr);
+
+    private:
+        size_t m_count, m_iterations;
+        std::vector<benchmark_result>& m_results;
+    };
+
+    using benchmark_callback = std::function<void(benchmark_context&)>;
+
+    // creates an empty directory for a benchmark to work in
+    fs::path create_temp_directory(const std::string& name);
+
+    struct benchmark_registrar {
+        benchmark_registrar(const std::string& name, const benchmark_callback& callback);
+    };
+} // namespace sge::bench
+
+#define SGE_BENCHMARK(name)                                                                        \
+    static void bench_##name(::sge::bench::benchmark_context& context);                            \
+    static ::sge::bench::benchmark_registrar bench_registrar_##name(#name, bench_##name);          \
+    static void bench_##name(::sge::bench::benchmark_context& context)
@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+
+namespace sge::bench {
+    // enough arithmetic per element that the work isn't dominated by memory bandwidth
+    static float process_element(size_t index) {
+        float value = (float)index;
+        for (size_t i = 0; i < 64; i++) {
+            value = std::sqrt(value * value + 1.f);
+        }
+
+        return value;
+    }
+
+    SGE_BENCHMARK(job_system_scaling) {
+        size_t count = context.get_count();
+        std::vector<float> output(count);
+
+        std::vector<uint32_t> worker_counts = { 0 };
+        for (uint32_t workers = 1; workers <= job_system::get_default_worker_count();
+             workers *= 2) {
+            worker_counts.push_back(workers);
+        }
+
+        uint32_t default_count = job_system::get_default_worker_count();
+        if (worker_counts.back() != default_count) {
+            worker_counts.push_back(default_count);
+        }
+
+        for (uint32_t workers : worker_counts) {
+            job_system::init(workers);
+            std::string suffix = " (" + std::to_string(workers) + " workers)";
+
+            context.measure("parallel_for" + suffix, [&]() {
+                job_system::parallel_for(
+                    0, count,
+                    [&](size_t first, size_t last) {
+                        for (size_t i = first; i < last; i++) {
+                            output[i] = process_element(i);
+                        }
+                    },
+                    256);
+            });
+
+            // one job per element, to measure the overhead of scheduling
+            context.measure("submit/wait" + suffix, [&]() {
+                job_counter counter;
+                for (size_t i = 0; i < count; i++) {
+                    job_system::submit([&output, i]() { output[i] = process_element(i); },
+                                       &counter);
+                }
+
+                job_system::wait(counter);
+            });
+
+            job_system::shutdown();
+        }
+    }
+} // namespace sge::bench
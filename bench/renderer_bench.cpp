@@ -0,0 +1,49 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+#include <sge/renderer/batch_geometry.h>
+
+namespace sge::bench {
+    // flushing a batch uploads to the GPU, so only its vertex generation is measured
+    SGE_BENCHMARK(batch_geometry) {
+        size_t count = context.get_count();
+
+        std::vector<batch_shape> shapes(count);
+        for (size_t i = 0; i < count; i++) {
+            auto& shape = shapes[i];
+            shape.type = batch_shape_type::quad;
+            shape.flags = i % 2 == 0 ? vertex_flags_none : vertex_flags_ellipse;
+            shape.color = glm::vec4(1.f);
+            shape.texture_index = i % 8;
+            shape.position = glm::vec2((float)(i % 100), (float)(i / 100));
+            shape.size = glm::vec2(1.f);
+            shape.rotation = (float)(i % 360);
+        }
+
+        std::vector<batch_vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        context.measure(
+            "generate_batch_geometry (quads)",
+            [&]() { generate_batch_geometry(shapes, vertices, indices); },
+            [&]() {
+                vertices.clear();
+                indices.clear();
+            });
+    }
+} // namespace sge::bench
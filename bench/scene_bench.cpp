@@ -0,0 +1,124 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+
+namespace sge::bench {
+    static constexpr int32_t z_layer_count = 16;
+
+    static ref<scene> create_sprite_scene(size_t count) {
+        auto _scene = ref<scene>::create();
+        for (size_t i = 0; i < count; i++) {
+            entity e = _scene->create_entity("Sprite " + std::to_string(i));
+
+            auto& transform = e.get_component<transform_component>();
+            transform.translation = glm::vec2((float)(i % 100), (float)(i / 100));
+            transform.z_layer = (int32_t)(i % z_layer_count);
+
+            auto& sprite = e.add_component<sprite_renderer_component>();
+            sprite.color = glm::vec4((float)(i % 7) / 7.f, 0.5f, 1.f, 1.f);
+        }
+
+        return _scene;
+    }
+
+    static ref<scene> create_physics_scene(size_t count) {
+        auto _scene = ref<scene>::create();
+
+        // bodies are spread out so that the benchmark measures syncing and stepping rather
+        // than contact resolution
+        for (size_t i = 0; i < count; i++) {
+            entity e = _scene->create_entity();
+
+            auto& transform = e.get_component<transform_component>();
+            transform.translation = glm::vec2((float)(i % 100) * 2.f, (float)(i / 100) * 2.f);
+
+            e.add_component<rigid_body_component>(rigid_body_component::body_type::dynamic);
+            e.add_component<box_collider_component>();
+        }
+
+        return _scene;
+    }
+
+    SGE_BENCHMARK(scene_render_order) {
+        auto _scene = create_sprite_scene(context.get_count());
+        context.measure("scene::recalculate_render_order",
+                        [&]() { _scene->recalculate_render_order(); });
+    }
+
+    SGE_BENCHMARK(scene_copy) {
+        auto _scene = create_sprite_scene(context.get_count());
+
+        ref<scene> copied;
+        context.measure(
+            "scene::copy", [&]() { copied = _scene->copy(); }, [&]() { copied.reset(); });
+    }
+
+    SGE_BENCHMARK(scene_find_guid) {
+        auto _scene = create_sprite_scene(context.get_count());
+
+        // the worst case is an entity that was created last
+        std::vector<guid> ids;
+        _scene->for_each([&](entity e) { ids.push_back(e.get_guid()); });
+
+        guid id = ids.empty() ? guid(0) : ids.back();
+        context.measure("scene::find_guid", [&]() { _scene->find_guid(id); });
+    }
+
+    SGE_BENCHMARK(scene_serialization) {
+        auto _scene = create_sprite_scene(context.get_count());
+
+        fs::path directory = create_temp_directory("scene_serialization");
+        fs::path path = directory / "bench.sgescene";
+
+        context.measure("scene_serializer::serialize", [&]() {
+            scene_serializer serializer(_scene);
+            serializer.serialize(path);
+        });
+
+        auto deserialized = ref<scene>::create();
+        context.measure("scene_serializer::deserialize", [&]() {
+            scene_serializer serializer(deserialized);
+            serializer.deserialize(path);
+        });
+
+        fs::remove_all(directory);
+    }
+
+    SGE_BENCHMARK(scene_physics) {
+        auto _scene = create_physics_scene(context.get_count());
+
+        // only the physics system is of interest here, and there's no renderer to draw with
+        _scene->get_systems().remove_system("render");
+        _scene->on_start();
+
+        std::vector<entity> bodies;
+        _scene->for_each([&](entity e) { bodies.push_back(e); });
+
+        timestep ts(1.0 / 60.0);
+        context.measure(
+            "scene physics update (sync + step)", [&]() { _scene->on_runtime_update(ts); },
+            [&]() {
+                for (entity e : bodies) {
+                    _scene->mark_physics_dirty(e);
+                }
+            });
+
+        context.measure("scene physics update (step)", [&]() { _scene->on_runtime_update(ts); });
+        _scene->on_stop();
+    }
+} // namespace sge::bench
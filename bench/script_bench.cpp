@@ -0,0 +1,71 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "benchmark.h"
+
+namespace sge::bench {
+    // mono can't be initialized twice in one process, so the script engine is left running once
+    // it has been started
+    static bool init_script_engine() {
+        static std::optional<bool> initialized;
+        if (initialized.has_value()) {
+            return initialized.value();
+        }
+
+        fs::path core_assembly = fs::current_path() / "assets" / "assemblies" /
+                                 project::get_config() / "SGE.Scriptcore.dll";
+
+        initialized = fs::exists(core_assembly);
+        if (initialized.value()) {
+            script_engine::init();
+        } else {
+            spdlog::warn("{0} does not exist - skipping script benchmarks",
+                         core_assembly.string());
+        }
+
+        return initialized.value();
+    }
+
+    SGE_BENCHMARK(script_method_call) {
+        if (!init_script_engine()) {
+            return;
+        }
+
+        // a cheap instance method that every domain has
+        void* mscorlib = script_engine::get_mscorlib();
+        void* object_class = script_engine::get_class(mscorlib, "System.Object");
+        void* method = script_engine::get_method(object_class, "GetHashCode()");
+        void* thunk = script_engine::get_method_thunk(method);
+
+        auto instance = object_ref::from_object(script_engine::alloc_object(object_class));
+        size_t count = context.get_count();
+
+        context.measure("script_engine::call_method", [&]() {
+            void* object = instance->get();
+            for (size_t i = 0; i < count; i++) {
+                script_engine::call_method(object, method);
+            }
+        });
+
+        context.measure("script_engine::call_thunk", [&]() {
+            void* object = instance->get();
+            for (size_t i = 0; i < count; i++) {
+                script_engine::call_thunk<int32_t>(thunk, object);
+            }
+        });
+    }
+} // namespace sge::bench
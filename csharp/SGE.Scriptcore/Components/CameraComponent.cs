@@ -81,5 +81,16 @@ namespace SGE.Components
             }
             set => CoreInternalCalls.SetPerspectiveClips(mAddress, value);
         }
+
+        /// <summary>
+        /// The native data of this component, accessed without calling into the engine. The
+        /// projection isn't recalculated until <see cref="NotifyChanged"/> is called.
+        /// </summary>
+        public unsafe ref CameraData Data => ref *(CameraData*)mAddress.ToPointer();
+
+        /// <summary>
+        /// Applies changes made through <see cref="Data"/>.
+        /// </summary>
+        public void NotifyChanged() => CoreInternalCalls.NotifyCameraChanged(mAddress);
     }
 }
\ No newline at end of file
@@ -49,6 +49,11 @@ namespace SGE.Components
             get => CoreInternalCalls.IsColliderSensor(mAddress);
             set => CoreInternalCalls.SetIsColliderSensor(mAddress, mParent, value);
         }
+
+        /// <summary>
+        /// Applies changes made through the data of the collider.
+        /// </summary>
+        public void NotifyChanged() => CoreInternalCalls.NotifyPhysicsChanged(mParent);
     }
 
     /// <summary>
@@ -66,6 +71,12 @@ namespace SGE.Components
             }
             set => CoreInternalCalls.SetBoxSize(mAddress, mParent, value);
         }
+
+        /// <summary>
+        /// The native data of this component, accessed without calling into the engine. Writes
+        /// don't reach the physics world until <see cref="Collider{T}.NotifyChanged"/> is called.
+        /// </summary>
+        public unsafe ref BoxColliderData Data => ref *(BoxColliderData*)mAddress.ToPointer();
     }
 
     public sealed class CircleColliderComponent : Collider<CircleColliderComponent>
@@ -75,6 +86,12 @@ namespace SGE.Components
             get => CoreInternalCalls.GetCircleRadius(mAddress);
             set => CoreInternalCalls.SetCircleRadius(mAddress, mParent, value);
         }
+
+        /// <summary>
+        /// The native data of this component, accessed without calling into the engine. Writes
+        /// don't reach the physics world until <see cref="Collider{T}.NotifyChanged"/> is called.
+        /// </summary>
+        public unsafe ref CircleColliderData Data => ref *(CircleColliderData*)mAddress.ToPointer();
     }
 
     public sealed class ShapeColliderComponent : Collider<ShapeColliderComponent>
@@ -0,0 +1,121 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System.Runtime.InteropServices;
+
+namespace SGE.Components
+{
+    // these structs share their layout with the native components, and are read and written in
+    // place. native code asserts that the layouts match
+
+    /// <summary>
+    /// The data of a <see cref="TransformComponent"/>. Maps to sge::transform_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TransformData
+    {
+        public Vector2 Translation;
+        public int ZLayer;
+        public float Rotation;
+        public Vector2 Scale;
+    }
+
+    /// <summary>
+    /// The data of a <see cref="RigidBodyComponent"/>. Maps to sge::rigid_body_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RigidBodyData
+    {
+        public BodyType BodyType;
+        private byte mFixedRotation;
+        public ushort FilterCategory;
+        public ushort FilterMask;
+
+        public bool FixedRotation
+        {
+            get => mFixedRotation != 0;
+            set => mFixedRotation = (byte)(value ? 1 : 0);
+        }
+    }
+
+    /// <summary>
+    /// The data of a <see cref="BoxColliderComponent"/>. Maps to sge::box_collider_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct BoxColliderData
+    {
+        public float Density;
+        public float Friction;
+        public float Restitution;
+        public float RestitutionThreshold;
+        private byte mIsSensor;
+        public Vector2 Size;
+
+        public bool IsSensor
+        {
+            get => mIsSensor != 0;
+            set => mIsSensor = (byte)(value ? 1 : 0);
+        }
+    }
+
+    /// <summary>
+    /// The data of a <see cref="CircleColliderComponent"/>. Maps to sge::circle_collider_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CircleColliderData
+    {
+        public float Density;
+        public float Friction;
+        public float Restitution;
+        public float RestitutionThreshold;
+        private byte mIsSensor;
+        public float Radius;
+
+        public bool IsSensor
+        {
+            get => mIsSensor != 0;
+            set => mIsSensor = (byte)(value ? 1 : 0);
+        }
+    }
+
+    /// <summary>
+    /// The data of a <see cref="CameraComponent"/>. Maps to sge::camera_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct CameraData
+    {
+        private fixed float mProjection[16];
+
+        public ProjectionType ProjectionType;
+        public float FOV;
+        public CameraClips PerspectiveClips;
+        public float ViewSize;
+        public CameraClips OrthographicClips;
+        private float mAspectRatio;
+        private byte mPrimary;
+
+        /// <summary>
+        /// Set by the engine from the size of the viewport.
+        /// </summary>
+        public float AspectRatio => mAspectRatio;
+
+        public bool Primary
+        {
+            get => mPrimary != 0;
+            set => mPrimary = (byte)(value ? 1 : 0);
+        }
+    }
+}
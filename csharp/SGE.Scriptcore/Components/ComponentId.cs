@@ -0,0 +1,33 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System;
+
+namespace SGE.Components
+{
+    /// <summary>
+    /// Caches the native ID of a component type, so that the type doesn't have to be looked up
+    /// every time a component is accessed.
+    /// </summary>
+    /// <typeparam name="T">The type of component.</typeparam>
+    internal static class ComponentId<T>
+    {
+        /// <summary>
+        /// The ID assigned to this component type when component types were registered.
+        /// </summary>
+        public static readonly int Value = CoreInternalCalls.GetComponentTypeID(typeof(T));
+    }
+}
@@ -131,6 +131,17 @@ namespace SGE.Components
         {
             CoreInternalCalls.ApplyTorque(mParent, torque, wake);
         }
+
+        /// <summary>
+        /// The native data of this component, accessed without calling into the engine. Writes
+        /// don't reach the physics world until <see cref="NotifyChanged"/> is called.
+        /// </summary>
+        public unsafe ref RigidBodyData Data => ref *(RigidBodyData*)mAddress.ToPointer();
+
+        /// <summary>
+        /// Applies changes made through <see cref="Data"/>.
+        /// </summary>
+        public void NotifyChanged() => CoreInternalCalls.NotifyPhysicsChanged(mParent);
     }
 
     /// <summary>
@@ -149,7 +160,7 @@ namespace SGE.Components
         public ushort CategoryBits
         {
             get => CoreInternalCalls.GetFilterCategory(mComponent.Address);
-            set => CoreInternalCalls.SetFilterCategory(mComponent.Address, value);
+            set => CoreInternalCalls.SetFilterCategory(mComponent.Address, mComponent.Parent, value);
         }
 
         /// <summary>
@@ -158,7 +169,7 @@ namespace SGE.Components
         public ushort MaskBits
         {
             get => CoreInternalCalls.GetFilterMask(mComponent.Address);
-            set => CoreInternalCalls.SetFilterMask(mComponent.Address, value);
+            set => CoreInternalCalls.SetFilterMask(mComponent.Address, mComponent.Parent, value);
         }
 
         private readonly RigidBodyComponent mComponent;
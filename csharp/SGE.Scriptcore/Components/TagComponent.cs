@@ -24,7 +24,7 @@ namespace SGE.Components
         public string Tag
         {
             get => CoreInternalCalls.GetTag(mAddress);
-            set => CoreInternalCalls.SetTag(mAddress, value);
+            set => CoreInternalCalls.SetTag(mAddress, Parent, value);
         }
     }
 }
\ No newline at end of file
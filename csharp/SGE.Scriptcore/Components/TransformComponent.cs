@@ -29,13 +29,13 @@ namespace SGE.Components
                 CoreInternalCalls.GetTranslation(mAddress, out translation);
                 return translation;
             }
-            set => CoreInternalCalls.SetTranslation(mAddress, value);
+            set => CoreInternalCalls.SetTranslation(mAddress, mParent, value);
         }
 
         public float Rotation
         {
             get => CoreInternalCalls.GetRotation(mAddress);
-            set => CoreInternalCalls.SetRotation(mAddress, value);
+            set => CoreInternalCalls.SetRotation(mAddress, mParent, value);
         }
 
         public Vector2 Scale
@@ -46,7 +46,7 @@ namespace SGE.Components
                 CoreInternalCalls.GetScale(mAddress, out scale);
                 return scale;
             }
-            set => CoreInternalCalls.SetScale(mAddress, value);
+            set => CoreInternalCalls.SetScale(mAddress, mParent, value);
         }
 
         public int ZLayer
@@ -54,5 +54,18 @@ namespace SGE.Components
             get => CoreInternalCalls.GetZLayer(mAddress);
             set => CoreInternalCalls.SetZLayer(mAddress, Parent, value);
         }
+
+        /// <summary>
+        /// The native data of this component, accessed without calling into the engine. Writes
+        /// don't reach the physics world or the render order until <see cref="NotifyChanged"/>
+        /// is called. Adding a component of the same type to another entity may move the data.
+        /// </summary>
+        public unsafe ref TransformData Data => ref *(TransformData*)mAddress.ToPointer();
+
+        /// <summary>
+        /// Applies changes made through <see cref="Data"/>.
+        /// </summary>
+        /// <param name="zLayerChanged">If the render order has to be recalculated.</param>
+        public void NotifyChanged(bool zLayerChanged = false) => CoreInternalCalls.NotifyTransformChanged(mParent, zLayerChanged);
     }
 }
\ No newline at end of file
@@ -45,7 +45,7 @@ namespace SGE
 
             return new T
             {
-                Address = CoreInternalCalls.AddComponent(typeof(T), this),
+                Address = CoreInternalCalls.AddComponent(ComponentId<T>.Value, mID, mScene.mNativeAddress),
                 Parent = this
             };
         }
@@ -55,7 +55,8 @@ namespace SGE
         /// </summary>
         /// <typeparam name="T">A type of a component.</typeparam>
         /// <returns>See above.</returns>
-        public bool HasComponent<T>() => CoreInternalCalls.HasComponent(typeof(T), this);
+        public bool HasComponent<T>() =>
+            CoreInternalCalls.HasComponent(ComponentId<T>.Value, mID, mScene.mNativeAddress);
 
         /// <summary>
         /// Retrieves a component of the specified type.
@@ -71,7 +72,7 @@ namespace SGE
 
             return new T
             {
-                Address = CoreInternalCalls.GetComponent(typeof(T), this),
+                Address = CoreInternalCalls.GetComponent(ComponentId<T>.Value, mID, mScene.mNativeAddress),
                 Parent = this
             };
         }
@@ -0,0 +1,200 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using SGE.Components;
+using System;
+using System.Collections;
+using System.Collections.Generic;
+
+namespace SGE
+{
+    /// <summary>
+    /// A set of component types to search a scene for. Running a query fills a buffer with the IDs
+    /// of every active entity that has all of the types, which is reused from run to run.
+    /// </summary>
+    public sealed class EntityQuery : IEnumerable<Entity>
+    {
+        /// <summary>
+        /// Runs the query and iterates over the entities it found. The results are kept until the
+        /// enumerator is disposed, even if the query is run again in the meantime.
+        /// </summary>
+        public struct Enumerator : IEnumerator<Entity>
+        {
+            internal Enumerator(EntityQuery query)
+            {
+                mQuery = query;
+                mCount = query.Run();
+                mIDs = query.LendBuffer();
+                mIndex = -1;
+            }
+
+            public Entity Current => mQuery.mScene.GetEntity(mIDs[mIndex]);
+            object IEnumerator.Current => Current;
+
+            public void Dispose() => mQuery.ReturnBuffer(mIDs);
+            public void Reset() => mIndex = -1;
+
+            public bool MoveNext()
+            {
+                if (mIndex + 1 < mCount)
+                {
+                    mIndex++;
+                    return true;
+                }
+
+                return false;
+            }
+
+            private readonly EntityQuery mQuery;
+            private readonly uint[] mIDs;
+            private readonly int mCount;
+            private int mIndex;
+        }
+
+        private const int InitialCapacity = 64;
+
+        internal EntityQuery(Scene scene, int[] typeIDs)
+        {
+            mScene = scene;
+            mTypeIDs = typeIDs;
+            mIDs = new uint[InitialCapacity];
+            mCount = 0;
+            mBufferLent = false;
+        }
+
+        /// <summary>
+        /// Searches the scene for matching entities.
+        /// The results of the previous run are overwritten.
+        /// </summary>
+        /// <returns>The number of entities found.</returns>
+        public unsafe int Run()
+        {
+            // an enumerator is still reading the last results
+            if (mBufferLent)
+            {
+                mIDs = new uint[mIDs.Length];
+                mBufferLent = false;
+            }
+
+            while (true)
+            {
+                int count;
+                fixed (int* typeIDs = mTypeIDs)
+                {
+                    fixed (uint* ids = mIDs)
+                    {
+                        count = CoreInternalCalls.QueryEntities(mScene.mNativeAddress, (IntPtr)typeIDs,
+                            mTypeIDs.Length, (IntPtr)ids, mIDs.Length);
+                    }
+                }
+
+                // if the buffer was too small, grow it and ask again
+                if (count <= mIDs.Length)
+                {
+                    mCount = count;
+                    return count;
+                }
+
+                mIDs = new uint[Math.Max(count, mIDs.Length * 2)];
+            }
+        }
+
+        private uint[] LendBuffer()
+        {
+            mBufferLent = true;
+            return mIDs;
+        }
+
+        private void ReturnBuffer(uint[] buffer)
+        {
+            // buffers replaced while they were lent are left to the garbage collector
+            if (buffer == mIDs)
+            {
+                mBufferLent = false;
+            }
+        }
+
+        /// <summary>
+        /// The number of entities found the last time this query was run.
+        /// </summary>
+        public int Count => mCount;
+
+        /// <summary>
+        /// The IDs of the entities found the last time this query was run.
+        /// Only the first <see cref="Count"/> elements are valid.
+        /// </summary>
+        public uint[] IDs => mIDs;
+
+        /// <summary>
+        /// The scene this query searches.
+        /// </summary>
+        public Scene Scene => mScene;
+
+        /// <summary>
+        /// Retrieves the entity object of one of the results of the last run.
+        /// </summary>
+        /// <param name="index">The index of the result.</param>
+        /// <returns>The entity.</returns>
+        /// <exception cref="IndexOutOfRangeException" />
+        public Entity this[int index]
+        {
+            get
+            {
+                if (index < 0 || index >= mCount)
+                {
+                    throw new IndexOutOfRangeException();
+                }
+
+                return mScene.GetEntity(mIDs[index]);
+            }
+        }
+
+        public Enumerator GetEnumerator() => new Enumerator(this);
+        IEnumerator<Entity> IEnumerable<Entity>.GetEnumerator() => GetEnumerator();
+        IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+
+        private readonly Scene mScene;
+        private readonly int[] mTypeIDs;
+        private uint[] mIDs;
+        private int mCount;
+        private bool mBufferLent;
+    }
+
+    internal static class QueryTypes<T1> where T1 : Component<T1>, new()
+    {
+        public static readonly int[] IDs = { ComponentId<T1>.Value };
+    }
+
+    internal static class QueryTypes<T1, T2>
+        where T1 : Component<T1>, new()
+        where T2 : Component<T2>, new()
+    {
+        public static readonly int[] IDs = { ComponentId<T1>.Value, ComponentId<T2>.Value };
+    }
+
+    internal static class QueryTypes<T1, T2, T3>
+        where T1 : Component<T1>, new()
+        where T2 : Component<T2>, new()
+        where T3 : Component<T3>, new()
+    {
+        public static readonly int[] IDs =
+        {
+            ComponentId<T1>.Value,
+            ComponentId<T2>.Value,
+            ComponentId<T3>.Value
+        };
+    }
+}
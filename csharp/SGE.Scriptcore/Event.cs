@@ -15,6 +15,7 @@
 */
 
 using System;
+using System.Collections.Generic;
 using System.Reflection;
 
 namespace SGE
@@ -87,6 +88,29 @@ namespace SGE
         public EventID ID { get; }
     }
 
+    /// <summary>
+    /// Limits the events a script receives to the given types. Scripts without this attribute
+    /// receive every type of event.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Class, AllowMultiple = true, Inherited = true)]
+    public sealed class EventSubscriptionAttribute : Attribute
+    {
+        public EventSubscriptionAttribute(params EventID[] ids)
+        {
+            foreach (EventID id in ids)
+            {
+                if (id == EventID.None)
+                {
+                    throw new ArgumentException("Invalid event ID!");
+                }
+            }
+
+            IDs = ids;
+        }
+
+        public IReadOnlyList<EventID> IDs { get; }
+    }
+
     public sealed class EventDispatcher
     {
         public delegate bool DispatcherCallback<T>(T @event) where T : Event;
@@ -101,6 +101,6 @@ namespace SGE.Events
             }
         }
 
-        public bool Released => CoreInternalCalls.GetMouseButtonReleased(mAddress);
+        public bool Released => CoreInternalCalls.GetEventMouseButtonReleased(mAddress);
     }
 }
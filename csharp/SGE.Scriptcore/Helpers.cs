@@ -108,6 +108,26 @@ namespace SGE
             return @event;
         }
 
+        internal static int GetEventSubscriptionMask(Type scriptType)
+        {
+            var attributes = scriptType.GetCustomAttributes<EventSubscriptionAttribute>();
+
+            int mask = 0;
+            bool found = false;
+
+            foreach (var attribute in attributes)
+            {
+                foreach (EventID id in attribute.IDs)
+                {
+                    mask |= 1 << (int)id;
+                }
+
+                found = true;
+            }
+
+            return found ? mask : -1;
+        }
+
         internal static object CreateListObject(Type elementType)
         {
             var listType = typeof(List<>).MakeGenericType(new Type[] { elementType });
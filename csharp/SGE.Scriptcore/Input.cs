@@ -18,8 +18,26 @@ namespace SGE
 {
     public static class Input
     {
+        /// <summary>
+        /// Returned by <see cref="GetActionID(string)"/> if no action with the given name exists.
+        /// </summary>
+        public const uint InvalidAction = uint.MaxValue;
+
         public static bool GetKey(KeyCode key) => CoreInternalCalls.GetKey(key);
+
+        /// <summary>
+        /// Checks whether a key was pressed since the last frame.
+        /// </summary>
+        public static bool GetKeyPressed(KeyCode key) => CoreInternalCalls.GetKeyPressed(key);
+
+        /// <summary>
+        /// Checks whether a key was released since the last frame.
+        /// </summary>
+        public static bool GetKeyReleased(KeyCode key) => CoreInternalCalls.GetKeyReleased(key);
+
         public static bool GetMouseButton(MouseButton button) => CoreInternalCalls.GetMouseButton(button);
+        public static bool GetMouseButtonPressed(MouseButton button) => CoreInternalCalls.GetMouseButtonPressed(button);
+        public static bool GetMouseButtonReleased(MouseButton button) => CoreInternalCalls.GetMouseButtonReleased(button);
 
         public static Vector2 MousePosition
         {
@@ -30,5 +48,47 @@ namespace SGE
                 return position;
             }
         }
+
+        /// <summary>
+        /// Binds a key to a named action, creating the action if it doesn't exist.
+        /// </summary>
+        /// <param name="name">The name of the action.</param>
+        /// <param name="key">The key to bind.</param>
+        /// <returns>The ID of the action, which can be used for faster queries.</returns>
+        public static uint BindAction(string name, KeyCode key) => CoreInternalCalls.BindActionKey(name, key);
+
+        /// <summary>
+        /// Binds a mouse button to a named action, creating the action if it doesn't exist.
+        /// </summary>
+        /// <param name="name">The name of the action.</param>
+        /// <param name="button">The mouse button to bind.</param>
+        /// <returns>The ID of the action, which can be used for faster queries.</returns>
+        public static uint BindAction(string name, MouseButton button) => CoreInternalCalls.BindActionMouseButton(name, button);
+
+        /// <summary>
+        /// Removes every binding from an action.
+        /// </summary>
+        /// <param name="name">The name of the action.</param>
+        public static void ClearAction(string name) => CoreInternalCalls.ClearAction(name);
+
+        public static uint GetActionID(string name) => CoreInternalCalls.GetActionID(name);
+
+        /// <summary>
+        /// Checks whether any of the bindings of an action are held down.
+        /// </summary>
+        public static bool GetAction(uint id) => CoreInternalCalls.GetAction(id);
+        public static bool GetAction(string name) => GetAction(GetActionID(name));
+
+        /// <summary>
+        /// Checks whether any of the bindings of an action were pressed since the last frame.
+        /// </summary>
+        public static bool GetActionPressed(uint id) => CoreInternalCalls.GetActionPressed(id);
+        public static bool GetActionPressed(string name) => GetActionPressed(GetActionID(name));
+
+        /// <summary>
+        /// Checks whether any of the bindings of an action were released since the last frame.
+        /// </summary>
+        public static bool GetActionReleased(uint id) => CoreInternalCalls.GetActionReleased(id);
+        public static bool GetActionReleased(string name) => GetActionReleased(GetActionID(name));
     }
 }
@@ -116,21 +116,31 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void DestroyEntity(uint entityID, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void ReleaseEntity(uint entityID, IntPtr scene);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool IsEntityActive(uint entityID, IntPtr scene);
+        [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern bool FindEntity(GUID id, out uint entityID, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool FindEntityByTag(string tag, out uint entityID, IntPtr scene);
+        [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void ForEach(Delegate callback, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern string GetCollisionCategoryName(IntPtr scene, int index);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int QueryEntities(IntPtr scene, IntPtr typeIDs, int typeCount, IntPtr buffer, int capacity);
 
         #endregion
         #region Entity
 
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern IntPtr AddComponent(Type componentType, Entity entity);
+        public static extern int GetComponentTypeID(Type componentType);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern IntPtr AddComponent(int typeID, uint entityID, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern bool HasComponent(Type componentType, Entity entity);
+        public static extern bool HasComponent(int typeID, uint entityID, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern IntPtr GetComponent(Type componentType, Entity entity);
+        public static extern IntPtr GetComponent(int typeID, uint entityID, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetGUID(uint entityID, IntPtr scene, out GUID guid);
 
@@ -168,7 +178,7 @@ namespace SGE
         #region TagComponent
 
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetTag(IntPtr component, string tag);
+        public static extern void SetTag(IntPtr component, Entity entity, string tag);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern string GetTag(IntPtr component);
 
@@ -178,19 +188,21 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetTranslation(IntPtr component, out Vector2 translation);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetTranslation(IntPtr component, Vector2 translation);
+        public static extern void SetTranslation(IntPtr component, Entity entity, Vector2 translation);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern float GetRotation(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetRotation(IntPtr component, float rotation);
+        public static extern void SetRotation(IntPtr component, Entity entity, float rotation);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetScale(IntPtr component, out Vector2 scale);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetScale(IntPtr component, Vector2 scale);
+        public static extern void SetScale(IntPtr component, Entity entity, Vector2 scale);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern int GetZLayer(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void SetZLayer(IntPtr component, Entity entity, int zLayer);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NotifyTransformChanged(Entity entity, bool zLayerChanged);
 
         #endregion
         #region SpriteRendererComponent
@@ -241,6 +253,8 @@ namespace SGE
         public static extern void SetOrthographic(IntPtr component, float viewSize, CameraClips clips);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void SetPerspective(IntPtr component, float fov, CameraClips clips);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NotifyCameraChanged(IntPtr component);
 
         #endregion
         #region RigidBodyComponent
@@ -274,11 +288,13 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern ushort GetFilterCategory(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetFilterCategory(IntPtr component, ushort category);
+        public static extern void SetFilterCategory(IntPtr component, Entity entity, ushort category);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern ushort GetFilterMask(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetFilterMask(IntPtr component, ushort mask);
+        public static extern void SetFilterMask(IntPtr component, Entity entity, ushort mask);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NotifyPhysicsChanged(Entity entity);
 
         #endregion
         #region BoxColliderComponent
@@ -336,9 +352,31 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern bool GetKey(KeyCode key);
         [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetKeyPressed(KeyCode key);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetKeyReleased(KeyCode key);
+        [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern bool GetMouseButton(MouseButton button);
         [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetMouseButtonPressed(MouseButton button);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetMouseButtonReleased(MouseButton button);
+        [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetMousePosition(out Vector2 position);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern uint BindActionKey(string name, KeyCode key);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern uint BindActionMouseButton(string name, MouseButton button);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void ClearAction(string name);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern uint GetActionID(string name);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetAction(uint id);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetActionPressed(uint id);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool GetActionReleased(uint id);
 
         #endregion
         #region Event
@@ -394,7 +432,7 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetEventMouseButton(IntPtr address, out MouseButton button);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern bool GetMouseButtonReleased(IntPtr address);
+        public static extern bool GetEventMouseButtonReleased(IntPtr address);
 
         #endregion
         #region FileChangedEvent
@@ -457,6 +495,8 @@ namespace SGE
         public static extern void CreatePrefab(Entity entity, out IntPtr address);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern Entity InstantiatePrefab(IntPtr address, IntPtr scene);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern Entity InstantiatePooledPrefab(IntPtr address, IntPtr scene);
 
         #endregion
         #region Sound
@@ -39,5 +39,18 @@ namespace SGE
         {
             return CoreInternalCalls.InstantiatePrefab(mAddress, scene.mNativeAddress);
         }
+
+        /// <summary>
+        /// Instantiates this prefab, reusing an instance previously released with
+        /// <see cref="Scene.ReleaseEntity(Entity)"/> if one is available. A reused entity is reset
+        /// to the transform it was first instantiated with, and its script is replaced with a newly
+        /// constructed instance. As with <see cref="Instantiate(Scene)"/>, OnStart is not called.
+        /// </summary>
+        /// <param name="scene">The scene to instantiate this prefab in.</param>
+        /// <returns>The instantiated entity.</returns>
+        public Entity InstantiatePooled(Scene scene)
+        {
+            return CoreInternalCalls.InstantiatePooledPrefab(mAddress, scene.mNativeAddress);
+        }
     }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+using SGE.Components;
 using System;
 using System.Collections;
 using System.Collections.Generic;
@@ -146,6 +147,40 @@ namespace SGE
             }
 
             CoreInternalCalls.DestroyEntity(entity.ID, mNativeAddress);
+            mEntities.Remove(entity.ID);
+        }
+
+        /// <summary>
+        /// Returns an entity created with <see cref="Prefab.InstantiatePooled(Scene)"/> to its pool.
+        /// The entity stops updating, rendering, and simulating until it is reused. Entities that
+        /// were not pooled are destroyed.
+        /// </summary>
+        /// <param name="entity">The entity to release.</param>
+        /// <exception cref="InvalidOperationException" />
+        public void ReleaseEntity(Entity entity)
+        {
+            if (entity.Scene != this)
+            {
+                throw new InvalidOperationException("Attempted to release an entity with an incompatible scene!");
+            }
+
+            CoreInternalCalls.ReleaseEntity(entity.ID, mNativeAddress);
+        }
+
+        /// <summary>
+        /// Checks whether an entity is active, i.e. it is not waiting in a pool.
+        /// </summary>
+        /// <param name="entity">The entity to check.</param>
+        /// <returns>Whether the entity is active.</returns>
+        /// <exception cref="InvalidOperationException" />
+        public bool IsEntityActive(Entity entity)
+        {
+            if (entity.Scene != this)
+            {
+                throw new InvalidOperationException("Attempted to check an entity with an incompatible scene!");
+            }
+
+            return CoreInternalCalls.IsEntityActive(entity.ID, mNativeAddress);
         }
 
         /// <summary>
@@ -164,12 +199,85 @@ namespace SGE
             return null;
         }
 
+        /// <summary>
+        /// Attempts to find an entity with the given tag.
+        /// </summary>
+        /// <param name="tag">The tag to search for.</param>
+        /// <returns>An entity, if one was found. Returns null on failure.</returns>
+        public Entity FindEntityByTag(string tag)
+        {
+            uint entityID;
+            if (CoreInternalCalls.FindEntityByTag(tag, out entityID, mNativeAddress))
+            {
+                return new Entity(entityID, this);
+            }
+
+            return null;
+        }
+
         /// <summary>
         /// Iterates through every entity in the scene.
         /// </summary>
         /// <param name="callback">The callback called on every iteration.</param>
         public void ForEach(Action<Entity> callback) => CoreInternalCalls.ForEach(callback, mNativeAddress);
 
+        /// <summary>
+        /// Retrieves a query for every active entity with a component of the specified type.
+        /// Queries are reused, so calling this every frame does not allocate.
+        /// </summary>
+        /// <typeparam name="T1">The type of component to search for.</typeparam>
+        /// <returns>The query. Run it, or iterate over it, to find entities.</returns>
+        public EntityQuery Query<T1>() where T1 : Component<T1>, new() => GetQuery(QueryTypes<T1>.IDs);
+
+        /// <summary>
+        /// Retrieves a query for every active entity with components of both specified types.
+        /// Queries are reused, so calling this every frame does not allocate.
+        /// </summary>
+        /// <typeparam name="T1">The first type of component to search for.</typeparam>
+        /// <typeparam name="T2">The second type of component to search for.</typeparam>
+        /// <returns>The query. Run it, or iterate over it, to find entities.</returns>
+        public EntityQuery Query<T1, T2>()
+            where T1 : Component<T1>, new()
+            where T2 : Component<T2>, new() => GetQuery(QueryTypes<T1, T2>.IDs);
+
+        /// <summary>
+        /// Retrieves a query for every active entity with components of all three specified types.
+        /// Queries are reused, so calling this every frame does not allocate.
+        /// </summary>
+        /// <typeparam name="T1">The first type of component to search for.</typeparam>
+        /// <typeparam name="T2">The second type of component to search for.</typeparam>
+        /// <typeparam name="T3">The third type of component to search for.</typeparam>
+        /// <returns>The query. Run it, or iterate over it, to find entities.</returns>
+        public EntityQuery Query<T1, T2, T3>()
+            where T1 : Component<T1>, new()
+            where T2 : Component<T2>, new()
+            where T3 : Component<T3>, new() => GetQuery(QueryTypes<T1, T2, T3>.IDs);
+
+        // entity objects only hold an ID, so queries share one per entity rather than allocating
+        // or calling into native code for every result
+        internal Entity GetEntity(uint id)
+        {
+            if (!mEntities.TryGetValue(id, out Entity entity))
+            {
+                entity = new Entity(id, this);
+                mEntities.Add(id, entity);
+            }
+
+            return entity;
+        }
+
+        private EntityQuery GetQuery(int[] typeIDs)
+        {
+            // the id arrays are unique per set of types, so they're compared by reference
+            if (!mQueries.TryGetValue(typeIDs, out EntityQuery query))
+            {
+                query = new EntityQuery(this, typeIDs);
+                mQueries.Add(typeIDs, query);
+            }
+
+            return query;
+        }
+
         /// <summary>
         /// The names of the collision categories in this scene.
         /// If one doesn't have a name, it's corresponding element is empty.
@@ -208,5 +316,7 @@ namespace SGE
         public static bool operator !=(Scene lhs, Scene rhs) => !(lhs == rhs);
 
         internal readonly IntPtr mNativeAddress;
+        private readonly Dictionary<int[], EntityQuery> mQueries = new Dictionary<int[], EntityQuery>();
+        private readonly Dictionary<uint, Entity> mEntities = new Dictionary<uint, Entity>();
     }
 }
\ No newline at end of file
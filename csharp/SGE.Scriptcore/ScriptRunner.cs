@@ -0,0 +1,189 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+
+namespace SGE
+{
+    /// <summary>
+    /// Updates the scripts of a scene from managed code, so that the engine only has to call into
+    /// managed code once per frame. The engine keeps track of which scripts should be updated
+    /// and passes the changes along with each update.
+    /// </summary>
+    internal sealed class ScriptRunner
+    {
+        private sealed class ScriptGroup
+        {
+            public ScriptGroup(MethodInfo method)
+            {
+                Method = method;
+                IDs = new List<uint>();
+                Callbacks = new List<Action<Timestep>>();
+            }
+
+            public readonly MethodInfo Method;
+            public readonly List<uint> IDs;
+            public readonly List<Action<Timestep>> Callbacks;
+            public bool HasRemovedScripts;
+        }
+
+        private struct ScriptLocation
+        {
+            public ScriptGroup Group;
+            public int Index;
+        }
+
+        public ScriptRunner()
+        {
+            mGroups = new Dictionary<Type, ScriptGroup>();
+            mGroupList = new List<ScriptGroup>();
+            mLocations = new Dictionary<uint, ScriptLocation>();
+        }
+
+        internal void Update(Timestep ts, uint[] removed, uint[] addedIDs, Script[] added)
+        {
+            if (removed != null)
+            {
+                foreach (uint id in removed)
+                {
+                    Remove(id);
+                }
+            }
+
+            foreach (var group in mGroupList)
+            {
+                if (group.HasRemovedScripts)
+                {
+                    Compact(group);
+                }
+            }
+
+            if (added != null)
+            {
+                for (int i = 0; i < added.Length; i++)
+                {
+                    Add(addedIDs[i], added[i]);
+                }
+            }
+
+            foreach (var group in mGroupList)
+            {
+                // scripts removed while updating are set to null rather than taken out
+                var callbacks = group.Callbacks;
+                for (int i = 0; i < callbacks.Count; i++)
+                {
+                    try
+                    {
+                        callbacks[i]?.Invoke(ts);
+                    }
+                    catch (Exception exception)
+                    {
+                        Helpers.ReportException(exception);
+                    }
+                }
+            }
+        }
+
+        internal void Remove(uint id)
+        {
+            if (!mLocations.TryGetValue(id, out ScriptLocation location))
+            {
+                return;
+            }
+
+            location.Group.Callbacks[location.Index] = null;
+            location.Group.HasRemovedScripts = true;
+            mLocations.Remove(id);
+        }
+
+        private void Add(uint id, Script script)
+        {
+            Remove(id);
+
+            var group = GetGroup(script.GetType());
+            if (group == null)
+            {
+                return;
+            }
+
+            var callback = (Action<Timestep>)Delegate.CreateDelegate(typeof(Action<Timestep>), script, group.Method);
+            mLocations[id] = new ScriptLocation
+            {
+                Group = group,
+                Index = group.Callbacks.Count
+            };
+
+            group.IDs.Add(id);
+            group.Callbacks.Add(callback);
+        }
+
+        private ScriptGroup GetGroup(Type type)
+        {
+            if (mGroups.TryGetValue(type, out ScriptGroup group))
+            {
+                return group;
+            }
+
+            var flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic;
+            var method = type.GetMethod("OnUpdate", flags, null, new Type[] { typeof(Timestep) }, null);
+
+            if (method != null && method.ReturnType == typeof(void))
+            {
+                group = new ScriptGroup(method);
+                mGroupList.Add(group);
+            }
+
+            mGroups.Add(type, group);
+            return group;
+        }
+
+        private void Compact(ScriptGroup group)
+        {
+            int count = 0;
+            for (int i = 0; i < group.Callbacks.Count; i++)
+            {
+                var callback = group.Callbacks[i];
+                if (callback == null)
+                {
+                    continue;
+                }
+
+                uint id = group.IDs[i];
+                group.IDs[count] = id;
+                group.Callbacks[count] = callback;
+
+                mLocations[id] = new ScriptLocation
+                {
+                    Group = group,
+                    Index = count
+                };
+
+                count++;
+            }
+
+            int removedCount = group.Callbacks.Count - count;
+            group.IDs.RemoveRange(count, removedCount);
+            group.Callbacks.RemoveRange(count, removedCount);
+            group.HasRemovedScripts = false;
+        }
+
+        private readonly Dictionary<Type, ScriptGroup> mGroups;
+        private readonly List<ScriptGroup> mGroupList;
+        private readonly Dictionary<uint, ScriptLocation> mLocations;
+    }
+}
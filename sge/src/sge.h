@@ -28,6 +28,7 @@
 #include "sge/core/application.h"
 #include "sge/core/environment.h"
 #include "sge/core/input.h"
+#include "sge/core/job_system.h"
 #include "sge/core/window.h"
 
 // events
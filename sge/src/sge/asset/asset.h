@@ -27,6 +27,9 @@ namespace sge {
 
     class asset : public ref_counted {
     public:
+        // assets are loaded and shared across threads
+        static constexpr bool atomic_ref_count = true;
+
         guid id;
 
         virtual ~asset() = default;
@@ -18,8 +18,10 @@
 #include "sge/core/application.h"
 #include "sge/renderer/renderer.h"
 #include "sge/core/input.h"
+#include "sge/core/job_system.h"
 #include "sge/imgui/imgui_layer.h"
 #include "sge/script/script_engine.h"
+#include "sge/script/garbage_collector.h"
 #include "sge/asset/asset_serializers.h"
 #include "sge/asset/project.h"
 #include "sge/asset/sound.h"
@@ -93,6 +95,8 @@ namespace sge {
         }
     }
 
+    uint32_t application::get_worker_count() { return job_system::get_worker_count(); }
+
     bool application::is_watching(const fs::path& path) {
         if (path.empty()) {
             return false;
@@ -141,6 +145,11 @@ namespace sge {
         spdlog::info("initializing application: {0}...", m_title);
 
         pre_init();
+
+        uint32_t worker_count = m_worker_count.value_or(job_system::get_default_worker_count());
+        job_system::init(worker_count);
+        spdlog::info("job system workers: {0}", worker_count);
+
         if ((m_disabled_subsystems & subsystem_input) == 0) {
             input::init();
             m_initialized_subsystems |= subsystem_input;
@@ -223,6 +232,7 @@ namespace sge {
             input::shutdown();
         }
 
+        job_system::shutdown();
         spdlog::shutdown();
     }
 
@@ -233,11 +243,17 @@ namespace sge {
 
         m_running = true;
         while (m_running) {
+            if (is_subsystem_initialized(subsystem_input)) {
+                input::new_frame();
+            }
+
             for (const auto& [path, watcher] : m_watchers) {
                 watcher->update();
                 watcher->process_events(SGE_BIND_EVENT_FUNC(application::on_event));
             }
 
+            job_system::run_main_thread_jobs();
+
             if (!m_minimized) {
                 m_swapchain->new_frame();
                 renderer::new_frame();
@@ -281,6 +297,10 @@ namespace sge {
                 m_swapchain->present();
             }
 
+            if (is_subsystem_initialized(subsystem_script_engine)) {
+                garbage_collector::end_frame(m_minimized);
+            }
+
             m_window->on_update();
         }
     }
@@ -67,6 +67,9 @@ namespace sge {
         bool watch_directory(const fs::path& path);
         bool remove_watched_directory(const fs::path& path);
 
+        // number of job system workers. 0 until the application is initialized
+        uint32_t get_worker_count();
+
         virtual bool is_editor() { return false; }
         bool is_subsystem_initialized(subsystem id) { return (m_initialized_subsystems & id) != 0; }
 
@@ -82,6 +85,9 @@ namespace sge {
         void disable_subsystem(subsystem id);
         void reenable_subsystem(subsystem id);
 
+        // must be called before the application is initialized, e.g. in pre_init
+        void set_worker_count(uint32_t count) { m_worker_count = count; }
+
         layer_stack m_layer_stack;
         std::string m_title;
         std::unordered_map<fs::path, std::unique_ptr<directory_watcher>, path_hasher> m_watchers;
@@ -104,6 +110,7 @@ namespace sge {
         bool on_window_resize(window_resize_event& e);
         bool on_window_close(window_close_event& e);
 
+        std::optional<uint32_t> m_worker_count;
         uint32_t m_disabled_subsystems = 0;
         uint32_t m_initialized_subsystems = 0;
     };
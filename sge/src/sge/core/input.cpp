@@ -18,11 +18,53 @@
 #include "sge/core/input.h"
 #include "sge/core/application.h"
 #include "sge/events/input_events.h"
+#include <bitset>
+
 namespace sge {
+    template <size_t N>
+    struct button_state {
+        std::bitset<N> down;
+
+        // edges since the last frame started, and edges visible during the current frame. both
+        // are kept so that a press and release within one frame are still seen
+        std::bitset<N> pending_pressed, pending_released;
+        std::bitset<N> pressed, released;
+
+        void set(size_t index, bool is_down) {
+            if (down[index] == is_down) {
+                return;
+            }
+
+            down[index] = is_down;
+            if (is_down) {
+                pending_pressed[index] = true;
+            } else {
+                pending_released[index] = true;
+            }
+        }
+
+        void new_frame() {
+            pressed = pending_pressed;
+            released = pending_released;
+
+            pending_pressed.reset();
+            pending_released.reset();
+        }
+    };
+
+    struct input_action {
+        std::string name;
+        std::bitset<key_code_count> keys;
+        std::bitset<mouse_button_count> mouse_buttons;
+    };
+
     struct input_data_t {
-        std::map<key_code, bool> key_status;
-        std::map<mouse_button, bool> mouse_button_status;
+        button_state<key_code_count> keys;
+        button_state<mouse_button_count> mouse_buttons;
         glm::vec2 mouse_position = glm::vec2(0.f);
+
+        std::vector<input_action> actions;
+        std::unordered_map<std::string, uint32_t> action_indices;
     };
     static std::unique_ptr<input_data_t> input_data;
 
@@ -31,25 +73,19 @@ namespace sge {
 
     static bool input_on_pressed(key_pressed_event& e) {
         if (e.get_repeat_count() == 0) {
-            key_code code = e.get_key();
-            input_data->key_status[code] = true;
+            input_data->keys.set((size_t)e.get_key(), true);
         }
 
         return false;
     }
 
     static bool input_on_released(key_released_event& e) {
-        key_code code = e.get_key();
-        input_data->key_status[code] = false;
-
+        input_data->keys.set((size_t)e.get_key(), false);
         return false;
     }
 
     static bool input_mouse_button(mouse_button_event& e) {
-        mouse_button button = e.get_button();
-        bool released = e.get_released();
-        input_data->mouse_button_status[button] = !released;
-
+        input_data->mouse_buttons.set((size_t)e.get_button(), !e.get_released());
         return false;
     }
 
@@ -67,21 +103,45 @@ namespace sge {
         dispatcher.dispatch<mouse_moved_event>(input_mouse_position);
     }
 
-    bool input::get_key(key_code code) {
-        if (!input_data || input_data->key_status.find(code) == input_data->key_status.end()) {
-            return false;
+    void input::new_frame() {
+        if (!input_data) {
+            return;
         }
 
-        return input_data->key_status[code];
+        input_data->keys.new_frame();
+        input_data->mouse_buttons.new_frame();
+    }
+
+    static bool is_valid_key(key_code code) {
+        return input_data && (size_t)code < key_code_count;
+    }
+
+    static bool is_valid_button(mouse_button button) {
+        return input_data && (size_t)button < mouse_button_count;
+    }
+
+    bool input::get_key(key_code code) {
+        return is_valid_key(code) && input_data->keys.down[(size_t)code];
+    }
+
+    bool input::get_key_pressed(key_code code) {
+        return is_valid_key(code) && input_data->keys.pressed[(size_t)code];
+    }
+
+    bool input::get_key_released(key_code code) {
+        return is_valid_key(code) && input_data->keys.released[(size_t)code];
     }
 
     bool input::get_mouse_button(mouse_button button) {
-        if (!input_data ||
-            input_data->mouse_button_status.find(button) == input_data->mouse_button_status.end()) {
-            return false;
-        }
+        return is_valid_button(button) && input_data->mouse_buttons.down[(size_t)button];
+    }
+
+    bool input::get_mouse_button_pressed(mouse_button button) {
+        return is_valid_button(button) && input_data->mouse_buttons.pressed[(size_t)button];
+    }
 
-        return input_data->mouse_button_status[button];
+    bool input::get_mouse_button_released(mouse_button button) {
+        return is_valid_button(button) && input_data->mouse_buttons.released[(size_t)button];
     }
 
     glm::vec2 input::get_mouse_position() {
@@ -99,4 +159,101 @@ namespace sge {
 
         input_data->mouse_position = position;
     }
-} // namespace sge
\ No newline at end of file
+
+    static input_action* get_or_create_action(const std::string& name, uint32_t& id) {
+        if (!input_data) {
+            id = input::invalid_action;
+            return nullptr;
+        }
+
+        auto it = input_data->action_indices.find(name);
+        if (it != input_data->action_indices.end()) {
+            id = it->second;
+        } else {
+            id = (uint32_t)input_data->actions.size();
+            input_data->action_indices.insert(std::make_pair(name, id));
+
+            auto& action = input_data->actions.emplace_back();
+            action.name = name;
+        }
+
+        return &input_data->actions[id];
+    }
+
+    uint32_t input::bind_action(const std::string& name, key_code code) {
+        uint32_t id;
+        auto action = get_or_create_action(name, id);
+
+        if (action != nullptr && (size_t)code < key_code_count) {
+            action->keys[(size_t)code] = true;
+        }
+
+        return id;
+    }
+
+    uint32_t input::bind_action(const std::string& name, mouse_button button) {
+        uint32_t id;
+        auto action = get_or_create_action(name, id);
+
+        if (action != nullptr && (size_t)button < mouse_button_count) {
+            action->mouse_buttons[(size_t)button] = true;
+        }
+
+        return id;
+    }
+
+    void input::clear_action(const std::string& name) {
+        uint32_t id = get_action_id(name);
+        if (id == invalid_action) {
+            return;
+        }
+
+        // ids stay valid, so the action is emptied rather than removed
+        auto& action = input_data->actions[id];
+        action.keys.reset();
+        action.mouse_buttons.reset();
+    }
+
+    uint32_t input::get_action_id(const std::string& name) {
+        if (!input_data) {
+            return invalid_action;
+        }
+
+        auto it = input_data->action_indices.find(name);
+        if (it == input_data->action_indices.end()) {
+            return invalid_action;
+        }
+
+        return it->second;
+    }
+
+    template <typename Func>
+    static bool test_action(uint32_t id, Func&& get_state) {
+        if (!input_data || id >= input_data->actions.size()) {
+            return false;
+        }
+
+        const auto& action = input_data->actions[id];
+        const auto& [key_state, button_state] = get_state();
+
+        return (action.keys & key_state).any() || (action.mouse_buttons & button_state).any();
+    }
+
+    bool input::get_action(uint32_t id) {
+        return test_action(id, []() {
+            return std::tie(input_data->keys.down, input_data->mouse_buttons.down);
+        });
+    }
+
+    bool input::get_action_pressed(uint32_t id) {
+        return test_action(id, []() {
+            return std::tie(input_data->keys.pressed, input_data->mouse_buttons.pressed);
+        });
+    }
+
+    bool input::get_action_released(uint32_t id) {
+        return test_action(id, []() {
+            return std::tie(input_data->keys.released, input_data->mouse_buttons.released);
+        });
+    }
+} // namespace sge
@@ -20,18 +20,40 @@
 namespace sge {
     class input {
     public:
+        static constexpr uint32_t invalid_action = std::numeric_limits<uint32_t>::max();
+
         input() = delete;
 
         static void init();
         static void shutdown();
         static void on_event(event& e);
 
+        // makes the presses and releases since the last call visible to the *_pressed and
+        // *_released queries. called by the application at the start of each frame
+        static void new_frame();
+
         static bool get_key(key_code code);
+        static bool get_key_pressed(key_code code);
+        static bool get_key_released(key_code code);
+
         static bool get_mouse_button(mouse_button button);
+        static bool get_mouse_button_pressed(mouse_button button);
+        static bool get_mouse_button_released(mouse_button button);
 
         static glm::vec2 get_mouse_position();
         static void set_mouse_position(glm::vec2 position);
 
-        // todo: action mapping
+        // actions are named sets of keys and mouse buttons. an action is down while any of its
+        // bindings are
+        static uint32_t bind_action(const std::string& name, key_code code);
+        static uint32_t bind_action(const std::string& name, mouse_button button);
+        static void clear_action(const std::string& name);
+
+        // returns invalid_action if no action with the given name exists
+        static uint32_t get_action_id(const std::string& name);
+
+        static bool get_action(uint32_t id);
+        static bool get_action_pressed(uint32_t id);
+        static bool get_action_released(uint32_t id);
     };
-} // namespace sge
\ No newline at end of file
+} // namespace sge
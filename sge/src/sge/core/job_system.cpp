@@ -0,0 +1,401 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/core/job_system.h"
+#include "sge/core/environment.h"
+#include <condition_variable>
+#include <deque>
+
+namespace sge {
+    struct job_t {
+        job_callback callback;
+        job_counter* counter;
+    };
+
+    struct job_queue {
+        std::mutex mutex;
+        std::deque<job_t> jobs;
+
+        void push(job_t&& job) {
+            std::lock_guard lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+
+        // the owning worker takes from the back, everyone else from the front
+        bool pop(job_t& job, bool back) {
+            std::lock_guard lock(mutex);
+            if (jobs.empty()) {
+                return false;
+            }
+
+            if (back) {
+                job = std::move(jobs.back());
+                jobs.pop_back();
+            } else {
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            return true;
+        }
+    };
+
+    struct job_system_data {
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<job_queue>> worker_queues;
+
+        // jobs submitted by threads that aren't workers
+        job_queue injected_jobs;
+        job_queue main_thread_jobs;
+
+        // bumped whenever work is added or a counter finishes, so that sleeping threads can tell
+        // whether they missed anything
+        std::mutex wake_mutex;
+        std::condition_variable wake_condition;
+        uint64_t epoch = 0;
+        bool quit = false;
+
+        std::thread::id main_thread;
+    };
+
+    static std::unique_ptr<job_system_data> s_data;
+    static thread_local int32_t t_worker_index = -1;
+
+    static void wake_threads(bool all) {
+        {
+            std::lock_guard lock(s_data->wake_mutex);
+            s_data->epoch++;
+        }
+
+        if (all) {
+            s_data->wake_condition.notify_all();
+        } else {
+            s_data->wake_condition.notify_one();
+        }
+    }
+
+    static void push_job(job_t&& job, bool main_thread) {
+        if (main_thread) {
+            s_data->main_thread_jobs.push(std::move(job));
+        } else if (t_worker_index >= 0) {
+            s_data->worker_queues[t_worker_index]->push(std::move(job));
+        } else {
+            s_data->injected_jobs.push(std::move(job));
+        }
+
+        // the main thread may be the only one able to run the job
+        wake_threads(main_thread);
+    }
+
+    // job_counter keeps its state to itself
+    struct job_counter_access {
+        static void finish_job(job_counter* counter, std::exception_ptr exception);
+        static void add_job(const job_callback& callback, job_counter* counter,
+                            job_counter* dependency, bool main_thread);
+    };
+
+    void job_counter_access::finish_job(job_counter* counter, std::exception_ptr exception) {
+        if (counter == nullptr) {
+            if (exception) {
+                try {
+                    std::rethrow_exception(exception);
+                } catch (const std::exception& exc) {
+                    spdlog::error("unhandled exception in job: {0}", exc.what());
+                } catch (...) {
+                    spdlog::error("unhandled exception in job: unknown exception");
+                }
+            }
+
+            return;
+        }
+
+        std::vector<job_counter::continuation> continuations;
+        {
+            std::lock_guard lock(counter->m_mutex);
+            if (exception && !counter->m_exception) {
+                counter->m_exception = exception;
+            }
+
+            if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+
+            continuations = std::move(counter->m_continuations);
+            counter->m_continuations.clear();
+        }
+
+        for (auto& continuation : continuations) {
+            push_job({ std::move(continuation.callback), continuation.counter },
+                     continuation.main_thread);
+        }
+
+        // threads waiting on the counter need to know
+        if (s_data) {
+            wake_threads(true);
+        }
+    }
+
+    static void run_job(job_t& job) {
+        std::exception_ptr exception;
+        try {
+            job.callback();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        job_counter_access::finish_job(job.counter, exception);
+    }
+
+    static bool try_run_job() {
+        job_t job;
+        bool found = false;
+
+        if (t_worker_index < 0 && std::this_thread::get_id() == s_data->main_thread) {
+            found = s_data->main_thread_jobs.pop(job, false);
+        }
+
+        size_t worker_count = s_data->worker_queues.size();
+        if (!found && t_worker_index >= 0) {
+            found = s_data->worker_queues[t_worker_index]->pop(job, true);
+        }
+
+        if (!found) {
+            found = s_data->injected_jobs.pop(job, false);
+        }
+
+        // steal from the other workers, starting with the next one over
+        size_t start = t_worker_index < 0 ? 0 : (size_t)t_worker_index + 1;
+        for (size_t i = 0; !found && i < worker_count; i++) {
+            size_t index = (start + i) % worker_count;
+            if ((int32_t)index != t_worker_index) {
+                found = s_data->worker_queues[index]->pop(job, false);
+            }
+        }
+
+        if (found) {
+            run_job(job);
+        }
+
+        return found;
+    }
+
+    static void worker_thread(int32_t index) {
+        t_worker_index = index;
+
+        while (true) {
+            uint64_t epoch;
+            {
+                std::lock_guard lock(s_data->wake_mutex);
+                if (s_data->quit) {
+                    break;
+                }
+
+                epoch = s_data->epoch;
+            }
+
+            if (try_run_job()) {
+                continue;
+            }
+
+            std::unique_lock lock(s_data->wake_mutex);
+            s_data->wake_condition.wait(
+                lock, [epoch]() { return s_data->quit || s_data->epoch != epoch; });
+        }
+    }
+
+    void job_system::init(uint32_t worker_count) {
+        if (s_data) {
+            throw std::runtime_error("the job system has already been initialized!");
+        }
+
+        s_data = std::make_unique<job_system_data>();
+        s_data->main_thread = std::this_thread::get_id();
+
+        for (uint32_t i = 0; i < worker_count; i++) {
+            s_data->worker_queues.push_back(std::make_unique<job_queue>());
+        }
+
+        for (uint32_t i = 0; i < worker_count; i++) {
+            auto& thread = s_data->workers.emplace_back(worker_thread, (int32_t)i);
+            environment::set_thread_name(thread, "worker " + std::to_string(i));
+        }
+    }
+
+    void job_system::shutdown() {
+        if (!s_data) {
+            return;
+        }
+
+        // jobs that haven't been started are dropped
+        {
+            std::lock_guard lock(s_data->wake_mutex);
+            s_data->quit = true;
+        }
+
+        s_data->wake_condition.notify_all();
+        for (auto& thread : s_data->workers) {
+            thread.join();
+        }
+
+        s_data.reset();
+    }
+
+    bool job_system::is_initialized() { return (bool)s_data; }
+
+    uint32_t job_system::get_worker_count() {
+        return s_data ? (uint32_t)s_data->workers.size() : 0;
+    }
+
+    uint32_t job_system::get_default_worker_count() {
+        // leave a core for the main thread
+        return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    void job_counter_access::add_job(const job_callback& callback, job_counter* counter,
+                                     job_counter* dependency, bool main_thread) {
+        if (counter != nullptr) {
+            counter->m_value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // without workers, jobs are run as they are submitted
+        if (!s_data) {
+            job_t job = { callback, counter };
+            run_job(job);
+            return;
+        }
+
+        if (dependency != nullptr) {
+            std::lock_guard lock(dependency->m_mutex);
+            if (!dependency->is_done()) {
+                auto& continuation = dependency->m_continuations.emplace_back();
+                continuation.callback = callback;
+                continuation.counter = counter;
+                continuation.main_thread = main_thread;
+
+                return;
+            }
+        }
+
+        push_job({ callback, counter }, main_thread);
+    }
+
+    void job_system::submit(const job_callback& callback, job_counter* counter,
+                            job_counter* dependency) {
+        job_counter_access::add_job(callback, counter, dependency, false);
+    }
+
+    void job_system::submit_main_thread(const job_callback& callback, job_counter* counter,
+                                        job_counter* dependency) {
+        job_counter_access::add_job(callback, counter, dependency, true);
+    }
+
+    void job_system::wait(job_counter& counter) {
+        while (s_data && !counter.is_done()) {
+            uint64_t epoch;
+            {
+                std::lock_guard lock(s_data->wake_mutex);
+                epoch = s_data->epoch;
+            }
+
+            if (try_run_job()) {
+                continue;
+            }
+
+            // nothing to help with, so sleep until something changes
+            std::unique_lock lock(s_data->wake_mutex);
+            s_data->wake_condition.wait(
+                lock, [&]() { return counter.is_done() || s_data->epoch != epoch; });
+        }
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard lock(counter.m_mutex);
+            exception = counter.m_exception;
+            counter.m_exception = nullptr;
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void job_system::run_main_thread_jobs() {
+        if (!s_data || !is_main_thread()) {
+            return;
+        }
+
+        job_t job;
+        while (s_data->main_thread_jobs.pop(job, false)) {
+            run_job(job);
+        }
+    }
+
+    bool job_system::is_main_thread() {
+        return s_data && std::this_thread::get_id() == s_data->main_thread;
+    }
+
+    void job_system::parallel_for(size_t begin, size_t end,
+                                  const std::function<void(size_t, size_t)>& callback,
+                                  size_t grain_size) {
+        if (end <= begin) {
+            return;
+        }
+
+        size_t count = end - begin;
+        size_t max_ranges = ((size_t)get_worker_count() + 1) * 4;
+        size_t range_count = std::min((count + grain_size - 1) / std::max(grain_size, (size_t)1),
+                                      max_ranges);
+
+        if (range_count <= 1) {
+            callback(begin, end);
+            return;
+        }
+
+        size_t range_size = count / range_count;
+        size_t remainder = count % range_count;
+
+        job_counter counter;
+        size_t first = begin;
+        std::pair<size_t, size_t> own_range;
+
+        for (size_t i = 0; i < range_count; i++) {
+            size_t last = first + range_size + (i < remainder ? 1 : 0);
+
+            // the calling thread processes the first range itself
+            if (i == 0) {
+                own_range = std::make_pair(first, last);
+            } else {
+                submit([&callback, first, last]() { callback(first, last); }, &counter);
+            }
+
+            first = last;
+        }
+
+        std::exception_ptr exception;
+        try {
+            callback(own_range.first, own_range.second);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        // the other ranges reference the callback, so they have to finish first
+        wait(counter);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+} // namespace sge
@@ -0,0 +1,91 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+
+namespace sge {
+    using job_callback = std::function<void()>;
+
+    // Counts the jobs that are still pending. A counter must outlive the jobs that signal it.
+    class job_counter {
+    public:
+        job_counter() = default;
+        ~job_counter() = default;
+
+        job_counter(const job_counter&) = delete;
+        job_counter& operator=(const job_counter&) = delete;
+
+        bool is_done() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+    private:
+        struct continuation {
+            job_callback callback;
+            job_counter* counter;
+            bool main_thread;
+        };
+
+        std::atomic<uint32_t> m_value{ 0 };
+
+        // jobs waiting on this counter
+        std::mutex m_mutex;
+        std::vector<continuation> m_continuations;
+
+        // the first exception thrown by a job signaling this counter, rethrown by wait
+        std::exception_ptr m_exception;
+
+        friend class job_system;
+        friend struct job_counter_access;
+    };
+
+    // Runs jobs on a pool of worker threads. Each worker owns a queue of jobs and takes work from
+    // the other workers when its own queue runs dry.
+    class job_system {
+    public:
+        job_system() = delete;
+
+        // with 0 workers, jobs are only run by threads waiting on them
+        static void init(uint32_t worker_count);
+        static void shutdown();
+
+        static bool is_initialized();
+        static uint32_t get_worker_count();
+        static uint32_t get_default_worker_count();
+
+        // the counter, if given, is incremented now and decremented once the job has run. if a
+        // dependency is given, the job isn't started until it is done
+        static void submit(const job_callback& callback, job_counter* counter = nullptr,
+                           job_counter* dependency = nullptr);
+
+        // runs the job on the main thread the next time run_main_thread_jobs is called, or while
+        // the main thread is waiting
+        static void submit_main_thread(const job_callback& callback,
+                                       job_counter* counter = nullptr,
+                                       job_counter* dependency = nullptr);
+
+        // runs other jobs until the counter is done
+        static void wait(job_counter& counter);
+
+        static void run_main_thread_jobs();
+        static bool is_main_thread();
+
+        // splits [begin, end) into ranges of at least grain_size indices, which are processed in
+        // parallel. returns once every range has been processed
+        static void parallel_for(size_t begin, size_t end,
+                                 const std::function<void(size_t, size_t)>& callback,
+                                 size_t grain_size = 1);
+    };
+} // namespace sge
@@ -109,4 +109,7 @@ namespace sge {
     };
 
     enum class mouse_button : int32_t { left = 0, right, middle };
+
+    static constexpr size_t key_code_count = (size_t)key_code::RIGHT_ALT + 1;
+    static constexpr size_t mouse_button_count = (size_t)mouse_button::middle + 1;
 } // namespace sge
@@ -0,0 +1,72 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/core/string_pool.h"
+#include <deque>
+#include <string_view>
+namespace sge {
+    static struct {
+        // strings in a deque don't move when more are added, so the keys below stay valid
+        std::deque<std::string> strings = { std::string() };
+        std::unordered_map<std::string_view, string_handle> handles = { { std::string_view(), 0 } };
+
+        std::mutex mutex;
+    } s_string_pool_data;
+
+    string_handle string_pool::intern(const std::string& string) {
+        if (string.empty()) {
+            return empty;
+        }
+
+        std::lock_guard lock(s_string_pool_data.mutex);
+        auto it = s_string_pool_data.handles.find(string);
+        if (it != s_string_pool_data.handles.end()) {
+            return it->second;
+        }
+
+        auto handle = (string_handle)s_string_pool_data.strings.size();
+        const auto& stored = s_string_pool_data.strings.emplace_back(string);
+
+        s_string_pool_data.handles.insert(std::make_pair(std::string_view(stored), handle));
+        return handle;
+    }
+
+    std::optional<string_handle> string_pool::find(const std::string& string) {
+        std::lock_guard lock(s_string_pool_data.mutex);
+
+        auto it = s_string_pool_data.handles.find(string);
+        if (it == s_string_pool_data.handles.end()) {
+            return std::optional<string_handle>();
+        }
+
+        return it->second;
+    }
+
+    const std::string& string_pool::get(string_handle handle) {
+        std::lock_guard lock(s_string_pool_data.mutex);
+        if (handle >= s_string_pool_data.strings.size()) {
+            throw std::runtime_error("invalid string handle: " + std::to_string(handle));
+        }
+
+        return s_string_pool_data.strings[handle];
+    }
+
+    size_t string_pool::get_string_count() {
+        std::lock_guard lock(s_string_pool_data.mutex);
+        return s_string_pool_data.strings.size();
+    }
+} // namespace sge
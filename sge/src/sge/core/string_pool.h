@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+namespace sge {
+    using string_handle = uint32_t;
+
+    // Stores every distinct string it is given exactly once. Handles stay valid for the lifetime
+    // of the program.
+    class string_pool {
+    public:
+        string_pool() = delete;
+
+        // the handle of the empty string
+        static constexpr string_handle empty = 0;
+
+        static string_handle intern(const std::string& string);
+        static std::optional<string_handle> find(const std::string& string);
+        static const std::string& get(string_handle handle);
+        static size_t get_string_count();
+    };
+
+    // A string stored in the string pool. Comparisons only compare handles.
+    class interned_string {
+    public:
+        interned_string() : m_handle(string_pool::empty) {}
+        interned_string(const std::string& string) : m_handle(string_pool::intern(string)) {}
+        interned_string(const char* string) : m_handle(string_pool::intern(string)) {}
+
+        interned_string(const interned_string&) = default;
+        interned_string& operator=(const interned_string&) = default;
+
+        static interned_string from_handle(string_handle handle) {
+            interned_string string;
+            string.m_handle = handle;
+            return string;
+        }
+
+        string_handle get_handle() const { return m_handle; }
+        bool empty() const { return m_handle == string_pool::empty; }
+
+        const std::string& str() const { return string_pool::get(m_handle); }
+        const char* c_str() const { return str().c_str(); }
+        operator const std::string&() const { return str(); }
+
+        bool operator==(const interned_string& other) const { return m_handle == other.m_handle; }
+        bool operator!=(const interned_string& other) const { return !(*this == other); }
+
+    private:
+        string_handle m_handle;
+    };
+} // namespace sge
+
+namespace std {
+    template <>
+    struct hash<sge::interned_string> {
+        size_t operator()(const sge::interned_string& string) const {
+            hash<sge::string_handle> hasher;
+            return hasher(string.get_handle());
+        }
+    };
+} // namespace std
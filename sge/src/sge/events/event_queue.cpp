@@ -0,0 +1,111 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/events/event_queue.h"
+#include "sge/events/window_events.h"
+#include "sge/events/input_events.h"
+
+namespace sge {
+    bool event_queues::push(event& e) {
+        bool pushed = false;
+        event_dispatcher dispatcher(e);
+
+        auto push_typed = [&](auto& typed_event) {
+            using event_type = std::decay_t<decltype(typed_event)>;
+            get<event_type>().push(typed_event);
+            pushed = true;
+
+            return false;
+        };
+
+        dispatcher.dispatch<window_close_event>(push_typed);
+        dispatcher.dispatch<window_resize_event>(push_typed);
+        dispatcher.dispatch<key_pressed_event>(push_typed);
+        dispatcher.dispatch<key_released_event>(push_typed);
+        dispatcher.dispatch<key_typed_event>(push_typed);
+        dispatcher.dispatch<mouse_moved_event>(push_typed);
+        dispatcher.dispatch<mouse_scrolled_event>(push_typed);
+        dispatcher.dispatch<mouse_button_event>(push_typed);
+        dispatcher.dispatch<file_changed_event>(push_typed);
+
+        return pushed;
+    }
+
+    void event_queues::clear() {
+        for (auto& [id, queue] : m_queues) {
+            queue->clear();
+        }
+    }
+
+    void event_subscriptions::subscribe(entt::entity id, event_id type) {
+        auto& subscribers = m_subscribers[type];
+        if (std::find(subscribers.begin(), subscribers.end(), id) == subscribers.end()) {
+            subscribers.push_back(id);
+            m_subscription_counts[id]++;
+        }
+    }
+
+    void event_subscriptions::unsubscribe(entt::entity id, event_id type) {
+        auto it = m_subscribers.find(type);
+        if (it == m_subscribers.end()) {
+            return;
+        }
+
+        auto& subscribers = it->second;
+        auto removed = std::remove(subscribers.begin(), subscribers.end(), id);
+        if (removed == subscribers.end()) {
+            return;
+        }
+
+        subscribers.erase(removed, subscribers.end());
+
+        auto count = m_subscription_counts.find(id);
+        if (--count->second == 0) {
+            m_subscription_counts.erase(count);
+        }
+    }
+
+    void event_subscriptions::unsubscribe_all(entt::entity id) {
+        for (auto& [type, subscribers] : m_subscribers) {
+            subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), id),
+                              subscribers.end());
+        }
+
+        m_subscription_counts.erase(id);
+    }
+
+    bool event_subscriptions::is_subscribed(entt::entity id, event_id type) const {
+        auto it = m_subscribers.find(type);
+        if (it == m_subscribers.end()) {
+            return false;
+        }
+
+        const auto& subscribers = it->second;
+        return std::find(subscribers.begin(), subscribers.end(), id) != subscribers.end();
+    }
+
+    bool event_subscriptions::has_subscriptions(entt::entity id) const {
+        return m_subscription_counts.find(id) != m_subscription_counts.end();
+    }
+
+    const std::vector<entt::entity>& event_subscriptions::get_subscribers(event_id type) const {
+        static const std::vector<entt::entity> empty;
+
+        auto it = m_subscribers.find(type);
+        return it != m_subscribers.end() ? it->second : empty;
+    }
+} // namespace sge
@@ -0,0 +1,114 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/events/event.h"
+#include <entt/entt.hpp>
+
+namespace sge {
+    class event_queue_base {
+    public:
+        virtual ~event_queue_base() = default;
+
+        virtual size_t size() const = 0;
+        virtual event& get(size_t index) = 0;
+        virtual void clear() = 0;
+
+        bool empty() const { return size() == 0; }
+    };
+
+    // events of one type, stored by value until they are delivered
+    template <typename T>
+    class event_queue : public event_queue_base {
+    public:
+        static_assert(std::is_base_of_v<event, T>, "T must be an event!");
+
+        void push(const T& e) { m_events.push_back(e); }
+
+        virtual size_t size() const override { return m_events.size(); }
+        virtual event& get(size_t index) override { return m_events[index]; }
+        virtual void clear() override { m_events.clear(); }
+
+        typename std::vector<T>::iterator begin() { return m_events.begin(); }
+        typename std::vector<T>::iterator end() { return m_events.end(); }
+
+    private:
+        std::vector<T> m_events;
+    };
+
+    // Collects the events of a frame into one queue per event type.
+    class event_queues {
+    public:
+        event_queues() = default;
+        ~event_queues() = default;
+
+        event_queues(const event_queues&) = delete;
+        event_queues& operator=(const event_queues&) = delete;
+
+        template <typename T>
+        event_queue<T>& get() {
+            auto& queue = m_queues[T::get_static_id()];
+            if (!queue) {
+                queue = std::make_unique<event_queue<T>>();
+            }
+
+            return *(event_queue<T>*)queue.get();
+        }
+
+        template <typename T>
+        void push(const T& e) {
+            get<T>().push(e);
+        }
+
+        // copies an event of any of the engine's event types. returns false if the type is unknown
+        bool push(event& e);
+
+        template <typename Func>
+        void for_each(Func&& callback) {
+            for (auto& [id, queue] : m_queues) {
+                if (!queue->empty()) {
+                    callback(id, *queue);
+                }
+            }
+        }
+
+        void clear();
+
+    private:
+        std::map<event_id, std::unique_ptr<event_queue_base>> m_queues;
+    };
+
+    // Tracks which entities receive which types of events.
+    class event_subscriptions {
+    public:
+        void subscribe(entt::entity id, event_id type);
+        void unsubscribe(entt::entity id, event_id type);
+        void unsubscribe_all(entt::entity id);
+        bool is_subscribed(entt::entity id, event_id type) const;
+        bool has_subscriptions(entt::entity id) const;
+
+        const std::vector<entt::entity>& get_subscribers(event_id type) const;
+
+        void clear() {
+            m_subscribers.clear();
+            m_subscription_counts.clear();
+        }
+
+    private:
+        std::unordered_map<event_id, std::vector<entt::entity>> m_subscribers;
+        std::unordered_map<entt::entity, uint32_t> m_subscription_counts;
+    };
+} // namespace sge
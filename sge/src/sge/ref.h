@@ -15,17 +15,132 @@
 */
 
 #pragma once
+#include <atomic>
+#include <mutex>
 namespace sge {
+    class ref_counted;
+
+    template <typename T>
+    class ref;
+
+    template <typename T>
+    class weak_ref;
+
+    // Shared between an object and its weak references. The object pointer is cleared once the
+    // object is destroyed.
+    struct weak_ref_block {
+        weak_ref_block(const ref_counted* instance) {
+            object = instance;
+            references = 1;
+        }
+
+        void add_reference() { references.fetch_add(1, std::memory_order_relaxed); }
+        void release() {
+            if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        std::mutex mutex;
+        const ref_counted* object;
+
+        // the object holds a reference while it's alive
+        std::atomic<uint32_t> references;
+    };
+
     class ref_counted {
+    public:
+        // types that are shared with other threads (e.g. assets) set this to true. derived types
+        // must not change it
+        static constexpr bool atomic_ref_count = false;
+
     protected:
-        ref_counted() { m_ref_count = 0; }
+        ref_counted() {
+            m_ref_count = 0;
+            m_weak_block = nullptr;
+        }
+
+        // references belong to an object, not to its value
+        ref_counted(const ref_counted&) : ref_counted() {}
+        ref_counted& operator=(const ref_counted&) { return *this; }
+
+        ~ref_counted() { expire_weak_refs(); }
 
     private:
-        mutable uint64_t m_ref_count;
+        template <bool Atomic>
+        void add_reference() const {
+            if constexpr (Atomic) {
+                m_ref_count.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                uint64_t count = m_ref_count.load(std::memory_order_relaxed);
+                m_ref_count.store(count + 1, std::memory_order_relaxed);
+            }
+        }
+
+        // returns true if the last reference was removed
+        template <bool Atomic>
+        bool remove_reference() const {
+            if constexpr (Atomic) {
+                return m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            } else {
+                uint64_t count = m_ref_count.load(std::memory_order_relaxed) - 1;
+                m_ref_count.store(count, std::memory_order_relaxed);
+                return count == 0;
+            }
+        }
+
+        // fails if the object is already being destroyed
+        bool try_add_reference() const {
+            uint64_t count = m_ref_count.load(std::memory_order_relaxed);
+            while (count > 0) {
+                if (m_ref_count.compare_exchange_weak(count, count + 1,
+                                                      std::memory_order_acquire)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        weak_ref_block* get_weak_block() const {
+            weak_ref_block* block = m_weak_block.load(std::memory_order_acquire);
+            if (block == nullptr) {
+                auto created = new weak_ref_block(this);
+                if (m_weak_block.compare_exchange_strong(block, created,
+                                                         std::memory_order_acq_rel)) {
+                    block = created;
+                } else {
+                    delete created;
+                }
+            }
+
+            return block;
+        }
+
+        void expire_weak_refs() const {
+            weak_ref_block* block = m_weak_block.exchange(nullptr, std::memory_order_acq_rel);
+            if (block == nullptr) {
+                return;
+            }
+
+            // waits for weak refs that are in the middle of locking
+            {
+                std::lock_guard lock(block->mutex);
+                block->object = nullptr;
+            }
+
+            block->release();
+        }
+
+        mutable std::atomic<uint64_t> m_ref_count;
+        mutable std::atomic<weak_ref_block*> m_weak_block;
 
         template <typename T>
         friend class ref;
 
+        template <typename T>
+        friend class weak_ref;
+
 #ifdef SGE_INTERNAL
         template <typename T>
         friend class ref_counter;
@@ -43,13 +158,11 @@ namespace sge {
         }
 
         void operator++(int) {
-            m_object->m_ref_count++;
+            m_object->template add_reference<T::atomic_ref_count>();
         }
 
         void operator--(int) {
-            m_object->m_ref_count--;
-
-            if (m_object->m_ref_count == 0) {
+            if (m_object->template remove_reference<T::atomic_ref_count>()) {
                 delete m_object;
             }
         }
@@ -95,6 +208,11 @@ namespace sge {
             inrease_ref_count();
         }
 
+        ref(ref<T>&& other) noexcept {
+            m_instance = other.m_instance;
+            other.m_instance = nullptr;
+        }
+
         ref& operator=(std::nullptr_t) {
             decrease_ref_count();
             m_instance = nullptr;
@@ -108,6 +226,16 @@ namespace sge {
             return *this;
         }
 
+        ref& operator=(ref<T>&& other) noexcept {
+            if (this != &other) {
+                decrease_ref_count();
+                m_instance = other.m_instance;
+                other.m_instance = nullptr;
+            }
+
+            return *this;
+        }
+
         template <typename U>
         ref& operator=(const ref<U>& other) {
             static_assert(std::is_base_of_v<T, U>, "polymorphism or something");
@@ -166,23 +294,130 @@ namespace sge {
     private:
         void inrease_ref_count() const {
             if (m_instance) {
-                m_instance->m_ref_count++;
+                m_instance->template add_reference<T::atomic_ref_count>();
             }
         }
 
         void decrease_ref_count() const {
             if (m_instance) {
-                m_instance->m_ref_count--;
-                if (m_instance->m_ref_count <= 0) {
+                if (m_instance->template remove_reference<T::atomic_ref_count>()) {
                     delete m_instance;
-                    m_instance = nullptr;
                 }
+
+                m_instance = nullptr;
             }
         }
 
         mutable T* m_instance;
         template <typename U>
         friend class ref;
+
+        template <typename U>
+        friend class weak_ref;
+    };
+
+    // References an object without keeping it alive, e.g. for caches.
+    template <typename T>
+    class weak_ref {
+    public:
+        weak_ref() {
+            m_instance = nullptr;
+            m_block = nullptr;
+        }
+
+        weak_ref(std::nullptr_t) : weak_ref() {}
+
+        template <typename U>
+        weak_ref(const ref<U>& object) {
+            static_assert(std::is_base_of_v<T, U>, "polymorphism or something");
+
+            m_instance = (T*)object.raw();
+            m_block = m_instance ? m_instance->get_weak_block() : nullptr;
+            if (m_block) {
+                m_block->add_reference();
+            }
+        }
+
+        ~weak_ref() { reset(); }
+
+        weak_ref(const weak_ref<T>& other) {
+            m_instance = other.m_instance;
+            m_block = other.m_block;
+            if (m_block) {
+                m_block->add_reference();
+            }
+        }
+
+        weak_ref(weak_ref<T>&& other) noexcept {
+            m_instance = other.m_instance;
+            m_block = other.m_block;
+
+            other.m_instance = nullptr;
+            other.m_block = nullptr;
+        }
+
+        weak_ref& operator=(const weak_ref<T>& other) {
+            if (other.m_block) {
+                other.m_block->add_reference();
+            }
+
+            reset();
+            m_instance = other.m_instance;
+            m_block = other.m_block;
+            return *this;
+        }
+
+        weak_ref& operator=(weak_ref<T>&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_instance = other.m_instance;
+                m_block = other.m_block;
+
+                other.m_instance = nullptr;
+                other.m_block = nullptr;
+            }
+
+            return *this;
+        }
+
+        void reset() {
+            if (m_block) {
+                m_block->release();
+            }
+
+            m_instance = nullptr;
+            m_block = nullptr;
+        }
+
+        // returns null if the object has been destroyed
+        ref<T> lock() const {
+            ref<T> result;
+            if (m_block == nullptr) {
+                return result;
+            }
+
+            std::lock_guard lock(m_block->mutex);
+            if (m_block->object != nullptr && m_instance->try_add_reference()) {
+                // the reference was already added
+                result.m_instance = m_instance;
+            }
+
+            return result;
+        }
+
+        bool expired() const {
+            if (m_block == nullptr) {
+                return true;
+            }
+
+            std::lock_guard lock(m_block->mutex);
+            return m_block->object == nullptr;
+        }
+
+    private:
+        // only dereferenced while the object is known to be alive
+        T* m_instance;
+        weak_ref_block* m_block;
     };
 } // namespace sge
 
@@ -194,4 +429,4 @@ namespace std {
             return hasher(ref.raw());
         }
     };
-} // namespace std
\ No newline at end of file
+} // namespace std
@@ -0,0 +1,101 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/renderer/batch_geometry.h"
+namespace sge {
+    void generate_batch_geometry(const std::vector<batch_shape>& shapes,
+                                 std::vector<batch_vertex>& vertices,
+                                 std::vector<uint32_t>& indices) {
+        auto add_quad_indices = [&]() {
+            std::vector<uint32_t> quad_indices = { 0, 1, 3, 1, 2, 3 };
+            for (uint32_t& index : quad_indices) {
+                index += (uint32_t)vertices.size();
+            }
+            indices.insert(indices.end(), quad_indices.begin(), quad_indices.end());
+        };
+
+        for (const auto& shape : shapes) {
+            switch (shape.type) {
+            case batch_shape_type::quad: {
+                add_quad_indices();
+
+                auto rot_rad = glm::radians(shape.rotation);
+                auto cos_rot = glm::cos(rot_rad);
+                auto sin_rot = glm::sin(rot_rad);
+
+                glm::vec2 half_size = shape.size / 2.f;
+
+                // top right
+                auto v = &vertices.emplace_back();
+                v->position.x = half_size.x * cos_rot - half_size.y * sin_rot;
+                v->position.y = half_size.x * sin_rot + half_size.y * cos_rot;
+                v->position += shape.position;
+                v->color = shape.color;
+                v->uv = glm::vec2(1.f, 0.f);
+                v->texture_index = (int32_t)shape.texture_index;
+                v->flags = shape.flags;
+
+                // bottom right
+                v = &vertices.emplace_back();
+                v->position.x = half_size.x * cos_rot - -half_size.y * sin_rot;
+                v->position.y = half_size.x * sin_rot + -half_size.y * cos_rot;
+                v->position += shape.position;
+                v->color = shape.color;
+                v->uv = glm::vec2(1.f, 1.f);
+                v->texture_index = (int32_t)shape.texture_index;
+                v->flags = shape.flags;
+
+                // bottom left
+                v = &vertices.emplace_back();
+                v->position.x = -half_size.x * cos_rot - -half_size.y * sin_rot;
+                v->position.y = -half_size.x * sin_rot + -half_size.y * cos_rot;
+                v->position += shape.position;
+                v->color = shape.color;
+                v->uv = glm::vec2(0.f, 1.f);
+                v->texture_index = (int32_t)shape.texture_index;
+                v->flags = shape.flags;
+
+                // top left
+                v = &vertices.emplace_back();
+                v->position.x = -half_size.x * cos_rot - half_size.y * sin_rot;
+                v->position.y = -half_size.x * sin_rot + half_size.y * cos_rot;
+                v->position += shape.position;
+                v->color = shape.color;
+                v->uv = glm::vec2(0.f, 0.f);
+                v->texture_index = (int32_t)shape.texture_index;
+                v->flags = shape.flags;
+            } break;
+            case batch_shape_type::vertices: {
+                for (uint32_t index : shape.indices) {
+                    indices.push_back((uint32_t)(index + vertices.size()));
+                }
+
+                for (const auto& passed_vertex : shape.vertices) {
+                    auto& v = vertices.emplace_back();
+                    v.position = passed_vertex.position;
+                    v.color = shape.color;
+                    v.uv = passed_vertex.uv;
+                    v.texture_index = shape.texture_index;
+                    v.flags = shape.flags;
+                }
+            } break;
+            default:
+                throw std::runtime_error("invalid shape type!");
+            }
+        }
+    }
+} // namespace sge
@@ -0,0 +1,51 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/renderer.h"
+namespace sge {
+    enum vertex_flags : int32_t { vertex_flags_none = 0, vertex_flags_ellipse = 1 << 0 };
+
+    struct batch_vertex {
+        glm::vec2 position;
+        glm::vec4 color;
+        glm::vec2 uv;
+
+        int32_t texture_index;
+        int32_t flags;
+    };
+
+    enum class batch_shape_type { quad, vertices };
+    struct batch_shape {
+        batch_shape_type type;
+        int32_t flags;
+
+        glm::vec4 color;
+        size_t texture_index;
+
+        std::vector<mapped_vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        glm::vec2 position, size;
+        float rotation;
+    };
+
+    // Appends the vertices and indices of the given shapes. This is the part of flushing a batch
+    // that doesn't touch the GPU.
+    void generate_batch_geometry(const std::vector<batch_shape>& shapes,
+                                 std::vector<batch_vertex>& vertices,
+                                 std::vector<uint32_t>& indices);
+} // namespace sge
@@ -0,0 +1,252 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/renderer/material.h"
+namespace sge {
+    using material_key = std::pair<shader*, texture_2d*>;
+
+    static constexpr uint32_t index_bits = 16;
+    static constexpr material_id index_mask = (1 << index_bits) - 1;
+
+    static constexpr size_t chunk_size = 256;
+    static constexpr size_t max_chunks = ((size_t)index_mask + 1) / chunk_size;
+
+    struct material_slot {
+        material data;
+        material_key key;
+
+        // only increased, or decreased to a value above zero, without holding the lock
+        std::atomic<uint32_t> references = 0;
+        std::atomic<uint32_t> generation = 0;
+    };
+
+    // Slots live in fixed-size chunks that are never moved or freed while the table is in use, so
+    // get can index them without locking. A slot is only written while no handle refers to it, and
+    // is only freed or allocated while holding the lock.
+    static struct {
+        std::array<std::atomic<material_slot*>, max_chunks> chunks{};
+        std::vector<std::unique_ptr<material_slot[]>> owned_chunks;
+
+        // slot 0 is the default material and is never handed out
+        std::atomic<size_t> slot_count = 1;
+        std::vector<uint32_t> free_slots;
+        size_t used_count = 0;
+
+        std::map<material_key, material_id> ids;
+        std::mutex mutex;
+    } s_material_data;
+
+    static const material s_default_material;
+
+    static material_id make_id(uint32_t index, uint32_t generation) {
+        return (material_id)index | ((material_id)generation << index_bits);
+    }
+
+    static material_slot& get_slot(uint32_t index) {
+        auto chunk = s_material_data.chunks[index / chunk_size].load(std::memory_order_acquire);
+        return chunk[index % chunk_size];
+    }
+
+    // null if the id was freed
+    static material_slot* find_live_slot(material_id id) {
+        uint32_t index = id & index_mask;
+        if (index == 0 || index >= s_material_data.slot_count.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        auto& slot = get_slot(index);
+        if (make_id(index, slot.generation.load(std::memory_order_acquire)) != id) {
+            return nullptr;
+        }
+
+        return &slot;
+    }
+
+    // adds one to the count unless it's zero, i.e. the slot was freed
+    static bool try_increment(std::atomic<uint32_t>& references) {
+        uint32_t count = references.load(std::memory_order_relaxed);
+        while (count > 0) {
+            if (references.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // subtracts one from the count, unless that would release the slot
+    static bool try_decrement(std::atomic<uint32_t>& references) {
+        uint32_t count = references.load(std::memory_order_relaxed);
+        while (count > 1) {
+            if (references.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void free_slot(uint32_t index) {
+        auto& slot = get_slot(index);
+        s_material_data.ids.erase(slot.key);
+
+        slot.data = material();
+        slot.references.store(0, std::memory_order_relaxed);
+        slot.generation.fetch_add(1, std::memory_order_release);
+
+        s_material_data.free_slots.push_back(index);
+        s_material_data.used_count--;
+    }
+
+    static uint32_t allocate_slot() {
+        if (!s_material_data.free_slots.empty()) {
+            uint32_t index = s_material_data.free_slots.back();
+            s_material_data.free_slots.pop_back();
+            return index;
+        }
+
+        size_t index = s_material_data.slot_count.load(std::memory_order_relaxed);
+        if (index > index_mask) {
+            throw std::runtime_error("too many materials!");
+        }
+
+        size_t chunk_index = index / chunk_size;
+        if (s_material_data.chunks[chunk_index].load(std::memory_order_relaxed) == nullptr) {
+            auto& chunk = s_material_data.owned_chunks.emplace_back(
+                std::make_unique<material_slot[]>(chunk_size));
+
+            s_material_data.chunks[chunk_index].store(chunk.get(), std::memory_order_release);
+        }
+
+        s_material_data.slot_count.store(index + 1, std::memory_order_release);
+        return (uint32_t)index;
+    }
+
+    material_handle material_table::intern(ref<shader> _shader, ref<texture_2d> texture) {
+        if (!_shader && !texture) {
+            return material_handle();
+        }
+
+        std::lock_guard lock(s_material_data.mutex);
+        material_key key = std::make_pair(_shader.raw(), texture.raw());
+
+        auto it = s_material_data.ids.find(key);
+        if (it != s_material_data.ids.end()) {
+            get_slot(it->second & index_mask).references.fetch_add(1, std::memory_order_relaxed);
+            return material_handle(it->second);
+        }
+
+        uint32_t index = allocate_slot();
+        auto& slot = get_slot(index);
+
+        slot.data._shader = _shader;
+        slot.data.texture = texture;
+        slot.data.shader_id = _shader ? _shader->id : guid(0);
+        slot.key = key;
+        slot.references.store(1, std::memory_order_relaxed);
+
+        material_id id = make_id(index, slot.generation.load(std::memory_order_relaxed));
+        s_material_data.ids.insert(std::make_pair(key, id));
+        s_material_data.used_count++;
+
+        return material_handle(id);
+    }
+
+    const material& material_table::get(material_id id) {
+        uint32_t index = id & index_mask;
+        if (index == 0) {
+            return s_default_material;
+        }
+
+        if (index >= s_material_data.slot_count.load(std::memory_order_acquire)) {
+            throw std::runtime_error("invalid material id: " + std::to_string(id));
+        }
+
+        auto& slot = get_slot(index);
+
+#ifdef SGE_DEBUG
+        if (make_id(index, slot.generation.load(std::memory_order_acquire)) != id) {
+            throw std::runtime_error("material " + std::to_string(id) + " has been released!");
+        }
+#endif
+
+        return slot.data;
+    }
+
+    material_handle material_table::with_shader(material_id id, ref<shader> _shader) {
+        return intern(_shader, get(id).texture);
+    }
+
+    material_handle material_table::with_texture(material_id id, ref<texture_2d> texture) {
+        return intern(get(id)._shader, texture);
+    }
+
+    size_t material_table::get_material_count() {
+        std::lock_guard lock(s_material_data.mutex);
+        return s_material_data.used_count + 1;
+    }
+
+    void material_table::clear() {
+        std::lock_guard lock(s_material_data.mutex);
+
+        size_t slot_count = s_material_data.slot_count.load(std::memory_order_relaxed);
+        for (uint32_t i = 1; i < (uint32_t)slot_count; i++) {
+            if (get_slot(i).references.load(std::memory_order_relaxed) > 0) {
+                free_slot(i);
+            }
+        }
+    }
+
+    void material_table::add_reference(material_id id) {
+        if ((id & index_mask) == 0) {
+            return;
+        }
+
+        // the caller holds a handle, so the slot can only have been freed by clear
+        auto slot = find_live_slot(id);
+        if (slot == nullptr || !try_increment(slot->references)) {
+            return;
+        }
+
+        // cleared and reused between the check and the increment
+        if (make_id(id & index_mask, slot->generation.load(std::memory_order_acquire)) != id) {
+            std::lock_guard lock(s_material_data.mutex);
+            if (slot->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                free_slot(id & index_mask);
+            }
+        }
+    }
+
+    void material_table::remove_reference(material_id id) {
+        if ((id & index_mask) == 0) {
+            return;
+        }
+
+        auto slot = find_live_slot(id);
+        if (slot == nullptr || try_decrement(slot->references)) {
+            return;
+        }
+
+        // this may be the last reference. intern can add one while the lock is held, so check
+        // again before freeing the slot
+        std::lock_guard lock(s_material_data.mutex);
+        slot = find_live_slot(id);
+        if (slot != nullptr && slot->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            free_slot(id & index_mask);
+        }
+    }
+} // namespace sge
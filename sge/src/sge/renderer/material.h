@@ -0,0 +1,119 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/shader.h"
+#include "sge/renderer/texture.h"
+namespace sge {
+    // the low bits index a slot in the material table, the high bits count how many times that
+    // slot has been reused
+    using material_id = uint32_t;
+
+    // Sampling and blending are not part of a material: samplers are described by the texture,
+    // and every pipeline the renderer creates uses alpha blending.
+    struct material {
+        // null if the default shader is used
+        ref<shader> _shader;
+
+        // null if the white texture is used
+        ref<texture_2d> texture;
+
+        // cached so that sorting by material doesn't have to touch the shader
+        guid shader_id = 0;
+    };
+
+    class material_handle;
+
+    // Interns every combination of shader and texture used by sprites, so that components,
+    // render order keys, and the batcher can refer to a material by its index. Materials are
+    // reference counted through material_handle, and their slots are reused once the last handle
+    // is gone.
+    class material_table {
+    public:
+        material_table() = delete;
+
+        // no shader and no texture
+        static constexpr material_id default_material = 0;
+
+        static material_handle intern(ref<shader> _shader, ref<texture_2d> texture);
+
+        // doesn't lock. id must be held by a live handle
+        static const material& get(material_id id);
+
+        // swaps out one part of a material
+        static material_handle with_shader(material_id id, ref<shader> _shader);
+        static material_handle with_texture(material_id id, ref<texture_2d> texture);
+
+        // number of materials that are in use, including the default material
+        static size_t get_material_count();
+
+        // releases every material. handles that outlive this refer to the default material
+        static void clear();
+
+    private:
+        static void add_reference(material_id id);
+        static void remove_reference(material_id id);
+
+        friend class material_handle;
+    };
+
+    // Keeps a material in the table while it's referenced, e.g. by a sprite.
+    class material_handle {
+    public:
+        material_handle() { m_id = material_table::default_material; }
+        ~material_handle() { material_table::remove_reference(m_id); }
+
+        material_handle(const material_handle& other) {
+            m_id = other.m_id;
+            material_table::add_reference(m_id);
+        }
+
+        material_handle(material_handle&& other) noexcept {
+            m_id = other.m_id;
+            other.m_id = material_table::default_material;
+        }
+
+        material_handle& operator=(const material_handle& other) {
+            material_table::add_reference(other.m_id);
+            material_table::remove_reference(m_id);
+
+            m_id = other.m_id;
+            return *this;
+        }
+
+        material_handle& operator=(material_handle&& other) noexcept {
+            if (this != &other) {
+                material_table::remove_reference(m_id);
+
+                m_id = other.m_id;
+                other.m_id = material_table::default_material;
+            }
+
+            return *this;
+        }
+
+        material_id get_id() const { return m_id; }
+        operator material_id() const { return m_id; }
+
+    private:
+        // adopts a reference that the table has already added
+        explicit material_handle(material_id id) { m_id = id; }
+
+        material_id m_id;
+
+        friend class material_table;
+    };
+} // namespace sge
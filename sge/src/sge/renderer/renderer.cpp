@@ -16,44 +16,22 @@
 
 #include "sgepch.h"
 #include "sge/renderer/renderer.h"
+#include "sge/renderer/batch_geometry.h"
 #include "sge/renderer/shader.h"
 #include "sge/core/application.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_renderer.h"
 #endif
 namespace sge {
-    enum vertex_flags : int32_t { vertex_flags_none = 0, vertex_flags_ellipse = 1 << 0 };
-
-    struct vertex {
-        glm::vec2 position;
-        glm::vec4 color;
-        glm::vec2 uv;
-
-        int32_t texture_index;
-        int32_t flags;
-    };
-
-    enum class shape_type { quad, vertices };
-    struct shape_t {
-        shape_type type;
-        int32_t flags;
-
-        glm::vec4 color;
-        size_t texture_index;
-
-        std::vector<mapped_vertex> vertices;
-        std::vector<uint32_t> indices;
-
-        glm::vec2 position, size;
-        float rotation;
-    };
-
     struct batch_t {
-        std::vector<shape_t> shapes;
+        std::vector<batch_shape> shapes;
 
         ref<shader> _shader;
         const editor_camera* grid_camera = nullptr;
         std::vector<ref<texture_2d>> textures;
+
+        // texture slots of the materials drawn in this batch
+        std::unordered_map<material_id, size_t> material_textures;
     };
 
     struct vertex_data_t {
@@ -117,6 +95,7 @@ namespace sge {
 
         ref<uniform_buffer> camera_buffer, grid_buffer;
         ref<texture_2d> white_texture, black_texture;
+        ref<shader> default_shader;
 
         renderer::stats stats;
     } renderer_data;
@@ -145,6 +124,7 @@ namespace sge {
 
         renderer_data._shader_library = std::make_unique<shader_library>();
         load_shaders();
+        renderer_data.default_shader = renderer_data._shader_library->get("default");
 
         renderer_data.camera_buffer = uniform_buffer::create(sizeof(camera_data_t));
         renderer_data.grid_buffer = uniform_buffer::create(sizeof(grid_data_t));
@@ -179,6 +159,9 @@ namespace sge {
             throw std::runtime_error("not all render passes have been popped!");
         }
         renderer_data.frame_renderer_data.clear();
+        material_table::clear();
+
+        renderer_data.default_shader.reset();
         renderer_data._shader_library.reset();
         renderer_data.queues.clear();
 
@@ -323,7 +306,7 @@ namespace sge {
 
     void renderer::set_command_list(command_list& cmdlist) { renderer_data.cmdlist = &cmdlist; }
 
-    void renderer::set_shader(ref<shader> _shader) {
+    void renderer::set_shader(const ref<shader>& _shader) {
         auto& scene = *renderer_data.current_scene;
         if (scene.current_batch->_shader != _shader) {
             next_batch();
@@ -335,7 +318,7 @@ namespace sge {
     void renderer::begin_batch() {
         auto& scene = *renderer_data.current_scene;
         scene.current_batch = std::make_unique<batch_t>();
-        scene.current_batch->_shader = renderer_data._shader_library->get("default");
+        scene.current_batch->_shader = renderer_data.default_shader;
     }
 
     void renderer::next_batch() {
@@ -378,20 +361,20 @@ namespace sge {
                 pipeline_spec spec;
                 spec._shader = batch->_shader;
                 spec.renderpass = pass;
-                spec.input_layout.stride = sizeof(vertex);
+                spec.input_layout.stride = sizeof(batch_vertex);
                 spec.input_layout.attributes = {
-                    { vertex_attribute_type::float2, offsetof(vertex, position) },
-                    { vertex_attribute_type::float4, offsetof(vertex, color) },
-                    { vertex_attribute_type::float2, offsetof(vertex, uv) },
-                    { vertex_attribute_type::int1, offsetof(vertex, texture_index) },
-                    { vertex_attribute_type::int1, offsetof(vertex, flags) }
+                    { vertex_attribute_type::float2, offsetof(batch_vertex, position) },
+                    { vertex_attribute_type::float4, offsetof(batch_vertex, color) },
+                    { vertex_attribute_type::float2, offsetof(batch_vertex, uv) },
+                    { vertex_attribute_type::int1, offsetof(batch_vertex, texture_index) },
+                    { vertex_attribute_type::int1, offsetof(batch_vertex, flags) }
                 };
 
                 _pipeline = pipeline::create(spec);
                 _pipeline->set_uniform_buffer(renderer_data.camera_buffer, 0);
             }
 
-            std::vector<vertex> vertices;
+            std::vector<batch_vertex> vertices;
             std::vector<uint32_t> indices;
 
             auto add_quad_indices = [&]() {
@@ -415,7 +398,7 @@ namespace sge {
 
                 add_quad_indices();
 
-                vertex v;
+                batch_vertex v;
                 v.color = glm::vec4(1.f);
                 v.texture_index = -1;
                 v.flags = vertex_flags_none;
@@ -441,75 +424,7 @@ namespace sge {
                 vertices.push_back(v);
             }
 
-            for (const auto& shape : batch->shapes) {
-                switch (shape.type) {
-                case shape_type::quad: {
-                    add_quad_indices();
-
-                    auto rot_rad = glm::radians(shape.rotation);
-                    auto cos_rot = glm::cos(rot_rad);
-                    auto sin_rot = glm::sin(rot_rad);
-
-                    glm::vec2 half_size = shape.size / 2.f;
-
-                    // top right
-                    auto v = &vertices.emplace_back();
-                    v->position.x = half_size.x * cos_rot - half_size.y * sin_rot;
-                    v->position.y = half_size.x * sin_rot + half_size.y * cos_rot;
-                    v->position += shape.position;
-                    v->color = shape.color;
-                    v->uv = glm::vec2(1.f, 0.f);
-                    v->texture_index = (int32_t)shape.texture_index;
-                    v->flags = shape.flags;
-
-                    // bottom right
-                    v = &vertices.emplace_back();
-                    v->position.x = half_size.x * cos_rot - -half_size.y * sin_rot;
-                    v->position.y = half_size.x * sin_rot + -half_size.y * cos_rot;
-                    v->position += shape.position;
-                    v->color = shape.color;
-                    v->uv = glm::vec2(1.f, 1.f);
-                    v->texture_index = (int32_t)shape.texture_index;
-                    v->flags = shape.flags;
-
-                    // bottom left
-                    v = &vertices.emplace_back();
-                    v->position.x = -half_size.x * cos_rot - -half_size.y * sin_rot;
-                    v->position.y = -half_size.x * sin_rot + -half_size.y * cos_rot;
-                    v->position += shape.position;
-                    v->color = shape.color;
-                    v->uv = glm::vec2(0.f, 1.f);
-                    v->texture_index = (int32_t)shape.texture_index;
-                    v->flags = shape.flags;
-
-                    // top left
-                    v = &vertices.emplace_back();
-                    v->position.x = -half_size.x * cos_rot - half_size.y * sin_rot;
-                    v->position.y = -half_size.x * sin_rot + half_size.y * cos_rot;
-                    v->position += shape.position;
-                    v->color = shape.color;
-                    v->uv = glm::vec2(0.f, 0.f);
-                    v->texture_index = (int32_t)shape.texture_index;
-                    v->flags = shape.flags;
-                } break;
-                case shape_type::vertices: {
-                    for (uint32_t index : shape.indices) {
-                        indices.push_back((uint32_t)(index + vertices.size()));
-                    }
-
-                    for (const auto& passed_vertex : shape.vertices) {
-                        auto& v = vertices.emplace_back();
-                        v.position = passed_vertex.position;
-                        v.color = shape.color;
-                        v.uv = passed_vertex.uv;
-                        v.texture_index = shape.texture_index;
-                        v.flags = shape.flags;
-                    }
-                } break;
-                default:
-                    throw std::runtime_error("invalid shape type!");
-                }
-            }
+            generate_batch_geometry(batch->shapes, vertices, indices);
 
             for (size_t i = 0; i < batch->textures.size(); i++) {
                 // gonna have to assume 1
@@ -578,7 +493,7 @@ namespace sge {
         }
     }
 
-    size_t renderer::push_texture(ref<texture_2d> texture) {
+    size_t renderer::push_texture(const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
         std::optional<size_t> texture_index;
@@ -610,8 +525,8 @@ namespace sge {
     void renderer::draw_quad(glm::vec2 position, glm::vec2 size, const glm::vec4& color) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t quad;
-        quad.type = shape_type::quad;
+        batch_shape quad;
+        quad.type = batch_shape_type::quad;
         quad.position = position;
         quad.size = size;
         quad.rotation = 0.f;
@@ -623,11 +538,11 @@ namespace sge {
     }
 
     void renderer::draw_quad(glm::vec2 position, glm::vec2 size, const glm::vec4& color,
-                             ref<texture_2d> texture) {
+                             const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t quad;
-        quad.type = shape_type::quad;
+        batch_shape quad;
+        quad.type = batch_shape_type::quad;
         quad.position = position;
         quad.size = size;
         quad.rotation = 0.f;
@@ -642,8 +557,8 @@ namespace sge {
                                      const glm::vec4& color) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t quad;
-        quad.type = shape_type::quad;
+        batch_shape quad;
+        quad.type = batch_shape_type::quad;
         quad.position = position;
         quad.size = size;
         quad.rotation = rotation;
@@ -655,11 +570,11 @@ namespace sge {
     }
 
     void renderer::draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
-                                     const glm::vec4& color, ref<texture_2d> texture) {
+                                     const glm::vec4& color, const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t quad;
-        quad.type = shape_type::quad;
+        batch_shape quad;
+        quad.type = batch_shape_type::quad;
         quad.position = position;
         quad.size = size;
         quad.rotation = rotation;
@@ -670,11 +585,39 @@ namespace sge {
         batch.shapes.push_back(quad);
     }
 
+    void renderer::draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
+                                     const glm::vec4& color, material_id material) {
+        const auto& data = material_table::get(material);
+        set_shader(data._shader ? data._shader : renderer_data.default_shader);
+
+        auto& batch = *renderer_data.current_scene->current_batch;
+        size_t texture_index;
+
+        auto it = batch.material_textures.find(material);
+        if (it != batch.material_textures.end()) {
+            texture_index = it->second;
+        } else {
+            texture_index = push_texture(data.texture ? data.texture : renderer_data.white_texture);
+            batch.material_textures.insert(std::make_pair(material, texture_index));
+        }
+
+        batch_shape quad;
+        quad.type = batch_shape_type::quad;
+        quad.position = position;
+        quad.size = size;
+        quad.rotation = rotation;
+        quad.color = color;
+        quad.texture_index = texture_index;
+        quad.flags = vertex_flags_none;
+
+        batch.shapes.push_back(quad);
+    }
+
     void renderer::draw_ellipse(glm::vec2 position, glm::vec2 size, const glm::vec4& color) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t ellipse;
-        ellipse.type = shape_type::quad;
+        batch_shape ellipse;
+        ellipse.type = batch_shape_type::quad;
         ellipse.position = position;
         ellipse.size = size;
         ellipse.rotation = 0.f;
@@ -686,11 +629,11 @@ namespace sge {
     }
 
     void renderer::draw_ellipse(glm::vec2 position, glm::vec2 size, const glm::vec4& color,
-                                ref<texture_2d> texture) {
+                                const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t ellipse;
-        ellipse.type = shape_type::quad;
+        batch_shape ellipse;
+        ellipse.type = batch_shape_type::quad;
         ellipse.position = position;
         ellipse.size = size;
         ellipse.rotation = 0.f;
@@ -705,8 +648,8 @@ namespace sge {
                                         const glm::vec4& color) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t ellipse;
-        ellipse.type = shape_type::quad;
+        batch_shape ellipse;
+        ellipse.type = batch_shape_type::quad;
         ellipse.position = position;
         ellipse.size = size;
         ellipse.rotation = rotation;
@@ -718,11 +661,11 @@ namespace sge {
     }
 
     void renderer::draw_rotated_ellipse(glm::vec2 position, float rotation, glm::vec2 size,
-                                        const glm::vec4& color, ref<texture_2d> texture) {
+                                        const glm::vec4& color, const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t ellipse;
-        ellipse.type = shape_type::quad;
+        batch_shape ellipse;
+        ellipse.type = batch_shape_type::quad;
         ellipse.position = position;
         ellipse.size = size;
         ellipse.rotation = rotation;
@@ -737,8 +680,8 @@ namespace sge {
                               const std::vector<uint32_t>& indices, const glm::vec4& color) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
-        shape_t shape;
-        shape.type = shape_type::vertices;
+        batch_shape shape;
+        shape.type = batch_shape_type::vertices;
         shape.indices = indices;
         shape.color = color;
         shape.texture_index = push_texture(renderer_data.white_texture);
@@ -757,7 +700,7 @@ namespace sge {
 
     void renderer::draw_shape(const std::vector<mapped_vertex>& vertices,
                               const std::vector<uint32_t>& indices, const glm::vec4& color,
-                              ref<texture_2d> texture) {
+                              const ref<texture_2d>& texture) {
         auto& batch = *renderer_data.current_scene->current_batch;
 
         if (indices.size() % 3 != 0) {
@@ -765,8 +708,8 @@ namespace sge {
                 "the passed list of indices does not describe a set of triangles!");
         }
 
-        shape_t shape;
-        shape.type = shape_type::vertices;
+        batch_shape shape;
+        shape.type = batch_shape_type::vertices;
         shape.vertices = vertices;
         shape.indices = indices;
         shape.color = color;
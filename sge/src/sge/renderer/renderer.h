@@ -23,6 +23,7 @@
 #include "sge/renderer/index_buffer.h"
 #include "sge/renderer/texture.h"
 #include "sge/renderer/render_pass.h"
+#include "sge/renderer/material.h"
 #include "sge/scene/editor_camera.h"
 namespace sge {
     struct draw_data {
@@ -79,7 +80,7 @@ namespace sge {
         static void end_scene();
 
         static void set_command_list(command_list& cmdlist);
-        static void set_shader(ref<shader> _shader);
+        static void set_shader(const ref<shader>& _shader);
 
         static void begin_batch();
         static void next_batch();
@@ -89,7 +90,7 @@ namespace sge {
         static ref<render_pass> pop_render_pass();
         static void begin_render_pass();
 
-        static size_t push_texture(ref<texture_2d> texture);
+        static size_t push_texture(const ref<texture_2d>& texture);
 
         static void draw_grid(const editor_camera& camera);
 
@@ -97,27 +98,31 @@ namespace sge {
         // texture is used for the quad.
         static void draw_quad(glm::vec2 position, glm::vec2 size, const glm::vec4& color);
         static void draw_quad(glm::vec2 position, glm::vec2 size, const glm::vec4& color,
-                              ref<texture_2d> texture);
+                              const ref<texture_2d>& texture);
 
         static void draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
                                       const glm::vec4& color);
         static void draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
-                                      const glm::vec4& color, ref<texture_2d> texture);
+                                      const glm::vec4& color, const ref<texture_2d>& texture);
+
+        // switches to the material's shader if it isn't already bound
+        static void draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
+                                      const glm::vec4& color, material_id material);
 
         static void draw_ellipse(glm::vec2 position, glm::vec2 size, const glm::vec4& color);
         static void draw_ellipse(glm::vec2 position, glm::vec2 size, const glm::vec4& color,
-                                 ref<texture_2d> texture);
+                                 const ref<texture_2d>& texture);
 
         static void draw_rotated_ellipse(glm::vec2 position, float rotation, glm::vec2 size,
                                          const glm::vec4& color);
         static void draw_rotated_ellipse(glm::vec2 position, float rotation, glm::vec2 size,
-                                         const glm::vec4& color, ref<texture_2d> texture);
+                                         const glm::vec4& color, const ref<texture_2d>& texture);
 
         static void draw_shape(const std::vector<glm::vec2>& vertices,
                                const std::vector<uint32_t>& indices, const glm::vec4& color);
         static void draw_shape(const std::vector<mapped_vertex>& vertices,
                                const std::vector<uint32_t>& indices, const glm::vec4& color,
-                               ref<texture_2d> texture);
+                               const ref<texture_2d>& texture);
 
         struct stats {
             uint32_t draw_calls;
@@ -17,6 +17,7 @@
 #include "sge/scene/components.h"
 #include "sge/script/script_engine.h"
 #include "sge/script/script_helpers.h"
+#include "sge/script/script_callbacks.h"
 #include "sge/script/garbage_collector.h"
 
 using namespace entt::literals;
@@ -51,21 +52,20 @@ namespace sge {
             void* src_instance = csrc.instance->get();
             void* dst_instance = cdst.instance->get();
 
-            std::vector<void*> properties;
-            script_engine::iterate_properties(csrc._class, properties);
-
+            const auto& properties = script_property_cache::get(csrc._class);
             void* entity_class = script_helpers::get_core_type("SGE.Entity", true);
             void* asset_class = script_helpers::get_core_type("SGE.Asset", true);
 
-            for (void* property : properties) {
-                if (!script_helpers::is_property_serializable(property)) {
+            for (const auto& descriptor : properties) {
+                if (!descriptor.serializable) {
                     continue;
                 }
 
-                void* property_type = script_engine::get_property_type(property);
+                void* property = descriptor.property;
+                void* property_type = descriptor.type;
                 void* value = script_engine::get_property_value(src_instance, property);
 
-                if (script_engine::is_value_type(property_type)) {
+                if (descriptor.value_type) {
                     // good enough for now
                     const void* data = script_engine::unbox_object(value);
                     script_engine::set_property_value(dst_instance, property, (void*)data);
@@ -103,12 +103,12 @@ namespace sge {
 
     void script_component::verify_script(entity e) {
         if (_class != nullptr && !instance) {
+            const auto& callbacks = script_callback_cache::get(_class);
             void* object = script_engine::alloc_object(_class);
 
-            if (script_engine::get_method(_class, ".ctor") != nullptr) {
-                void* constructor = script_engine::get_method(_class, ".ctor()");
-                if (constructor != nullptr) {
-                    script_engine::call_method(object, constructor);
+            if (callbacks.has_constructor) {
+                if (callbacks.constructor != nullptr) {
+                    script_engine::call_method(object, callbacks.constructor);
                 } else {
                     class_name_t name_data;
                     script_engine::get_class_name(_class, name_data);
@@ -122,8 +122,7 @@ namespace sge {
             }
 
             void* entity_instance = script_helpers::create_entity_object(e);
-            void* entity_field = script_engine::get_field(_class, "__internal_mEntity");
-            script_engine::set_field_value(object, entity_field, entity_instance);
+            script_engine::set_field_value(object, callbacks.entity_field, entity_instance);
 
             instance = object_ref::from_object(object);
         }
@@ -18,10 +18,12 @@
 
 #include "sge/renderer/texture.h"
 #include "sge/renderer/shader.h"
+#include "sge/renderer/material.h"
 #include "sge/scene/runtime_camera.h"
 #include "sge/scene/entity_script.h"
 #include "sge/scene/entity.h"
 #include "sge/core/guid.h"
+#include "sge/core/string_pool.h"
 #include "sge/core/meta_register.h"
 #include "sge/scene/scene.h"
 #include "sge/script/garbage_collector.h"
@@ -54,8 +56,9 @@ namespace sge {
         id_component& operator=(const id_component&) = default;
     };
 
+    // tags should be changed through scene::set_tag, so that the scene can look entities up by tag
     struct tag_component {
-        std::string tag;
+        interned_string tag;
 
         tag_component() = default;
         tag_component(const std::string& t) : tag(t) {}
@@ -97,8 +100,7 @@ namespace sge {
         sprite_renderer_component& operator=(const sprite_renderer_component&) = default;
 
         glm::vec4 color = glm::vec4(1.f);
-        ref<texture_2d> texture;
-        ref<shader> _shader;
+        material_handle material;
 
         static void meta_register() {
             using namespace entt::literals;
@@ -276,6 +278,18 @@ namespace sge {
         }
     };
 
+    // attached to entities created through scene::instantiate_pooled
+    struct pooled_component {
+        prefab* source = nullptr;
+
+        // reapplied when the instance is reused
+        transform_component initial_transform;
+    };
+
+    // marks a pooled entity that has been released. inactive entities are not updated, rendered or
+    // simulated
+    struct inactive_component {};
+
     struct script_component {
         script_component() = default;
 
@@ -284,7 +298,7 @@ namespace sge {
 
         ref<object_ref> instance;
         void* _class = nullptr;
-        std::string class_name;
+        interned_string class_name;
         bool enabled = true;
 
         void verify_script(entity e);
@@ -307,6 +321,10 @@ namespace sge {
         if (e.has_all<sprite_renderer_component>()) {
             recalculate_render_order();
         }
+
+        if (e.has_all<rigid_body_component>()) {
+            mark_physics_dirty(e);
+        }
     }
 
     template <>
@@ -326,6 +344,30 @@ namespace sge {
         component.camera.set_render_target_size(width, height);
     }
 
+    template <>
+    inline void scene::on_component_added<rigid_body_component>(const entity& e,
+                                                                rigid_body_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_added<box_collider_component>(
+        const entity& e, box_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_added<circle_collider_component>(
+        const entity& e, circle_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_added<shape_collider_component>(
+        const entity& e, shape_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
     template <>
     inline void scene::on_component_removed<transform_component>(const entity& e,
                                                                  transform_component& component) {
@@ -334,6 +376,30 @@ namespace sge {
         }
     }
 
+    template <>
+    inline void scene::on_component_removed<rigid_body_component>(
+        const entity& e, rigid_body_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_removed<box_collider_component>(
+        const entity& e, box_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_removed<circle_collider_component>(
+        const entity& e, circle_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
+    template <>
+    inline void scene::on_component_removed<shape_collider_component>(
+        const entity& e, shape_collider_component& component) {
+        mark_physics_dirty(e);
+    }
+
     template <>
     inline void scene::on_component_removed<sprite_renderer_component>(
         const entity& e, sprite_renderer_component& component) {
@@ -30,6 +30,10 @@ namespace sge {
         virtual void on_event(event& e) {}
 
         virtual void on_collision(entity other) {}
+        virtual void on_collision_end(entity other) {}
+
+        // called when a contact begins. the normal points from this entity towards the other
+        virtual void on_collision_begin(entity other, glm::vec2 normal) { on_collision(other); }
 
     protected:
         template <typename T, typename... Args>
@@ -57,6 +61,13 @@ namespace sge {
             m_parent.remove_component<T>();
         }
 
+        // scripts that haven't subscribed to anything receive every event. once subscribed,
+        // on_event is only called for the types of events the script subscribed to
+        void subscribe_event(event_id id) { m_parent.get_scene()->subscribe_event(m_parent, id); }
+        void unsubscribe_event(event_id id) {
+            m_parent.get_scene()->unsubscribe_event(m_parent, id);
+        }
+
         entity m_parent;
         friend struct native_script_component;
     };
@@ -35,6 +35,12 @@ namespace sge {
     }
 
     void runtime_camera::recalculate_projection() {
+        // mirrored by SGE.Components.CameraData
+        static_assert(offsetof(runtime_camera, m_type) == sizeof(glm::mat4));
+        static_assert(offsetof(runtime_camera, m_fov) == sizeof(glm::mat4) + 4);
+        static_assert(offsetof(runtime_camera, m_orthographic_size) == sizeof(glm::mat4) + 16);
+        static_assert(offsetof(runtime_camera, m_aspect_ratio) == sizeof(glm::mat4) + 28);
+
         switch (m_type) {
         case projection_type::orthographic: {
             float ortho_left = -m_orthographic_size * m_aspect_ratio / 2.f;
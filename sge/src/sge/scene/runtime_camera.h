@@ -90,8 +90,11 @@ namespace sge {
             recalculate_projection();
         }
 
-    private:
+        // only needs to be called after the settings have been written to directly, as scripts do
+        // through SGE.Components.CameraData
         void recalculate_projection();
+
+    private:
         glm::mat4 m_projection;
 
         projection_type m_type = projection_type::orthographic;
@@ -17,11 +17,15 @@
 #include "sgepch.h"
 #include "sge/core/application.h"
 #include "sge/core/window.h"
+#include "sge/core/environment.h"
 #include "sge/renderer/renderer.h"
 #include "sge/scene/entity.h"
 #include "sge/scene/components.h"
+#include "sge/scene/scene_snapshot.h"
+#include "sge/scene/prefab.h"
 #include "sge/script/script_engine.h"
 #include "sge/script/script_helpers.h"
+#include "sge/script/script_callbacks.h"
 #include "sge/script/garbage_collector.h"
 
 #include <box2d/b2_world.h>
@@ -32,6 +36,9 @@
 #include <box2d/b2_contact.h>
 #include <box2d/b2_draw.h>
 
+#include <condition_variable>
+#include <algorithm>
+
 namespace sge {
     enum class collider_type { box, circle, shape };
 
@@ -75,84 +82,244 @@ namespace sge {
 
         std::vector<b2Fixture*> fixtures;
         b2Body* body;
+
+        // the transform the body was last synced with, so that changes made outside of the
+        // physics engine are noticed
+        glm::vec2 synced_translation, synced_scale;
+        float synced_rotation;
+    };
+
+    static void set_synced_transform(entity_physics_data& data,
+                                     const transform_component& transform) {
+        data.synced_translation = transform.translation;
+        data.synced_scale = transform.scale;
+        data.synced_rotation = transform.rotation;
+    }
+
+    static bool is_transform_synced(const entity_physics_data& data,
+                                    const transform_component& transform) {
+        return data.synced_translation == transform.translation &&
+               data.synced_scale == transform.scale && data.synced_rotation == transform.rotation;
+    }
+
+    struct body_snapshot {
+        entt::entity id;
+        b2Vec2 position;
+        float angle;
+    };
+
+    struct physics_worker_data {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        bool step_pending = false;
+        bool quit = false;
+        float timestep = 0.f;
+    };
+
+    enum class body_command_type {
+        force,
+        force_to_center,
+        linear_impulse,
+        linear_impulse_to_center,
+        torque,
+        linear_velocity,
+        angular_velocity
+    };
+
+    // a change to a body, queued while the physics thread owns the world. kept as plain data so
+    // that queueing doesn't allocate
+    struct body_command {
+        entt::entity id = entt::null;
+        body_command_type type;
+
+        b2Vec2 vector = b2Vec2(0.f, 0.f);
+        b2Vec2 point = b2Vec2(0.f, 0.f);
+        float scalar = 0.f;
+        bool wake = true;
+    };
+
+    static void execute_body_command(b2Body* body, const body_command& command) {
+        switch (command.type) {
+        case body_command_type::force:
+            body->ApplyForce(command.vector, command.point, command.wake);
+            break;
+        case body_command_type::force_to_center:
+            body->ApplyForceToCenter(command.vector, command.wake);
+            break;
+        case body_command_type::linear_impulse:
+            body->ApplyLinearImpulse(command.vector, command.point, command.wake);
+            break;
+        case body_command_type::linear_impulse_to_center:
+            body->ApplyLinearImpulseToCenter(command.vector, command.wake);
+            break;
+        case body_command_type::torque:
+            body->ApplyTorque(command.scalar, command.wake);
+            break;
+        case body_command_type::linear_velocity:
+            body->SetLinearVelocity(command.vector);
+            break;
+        case body_command_type::angular_velocity:
+            body->SetAngularVelocity(command.scalar);
+            break;
+        default:
+            throw std::runtime_error("invalid body command type!");
+        }
+    }
+
+    struct contact_event {
+        entt::entity _entity, other;
+
+        // points from the entity towards the other entity
+        glm::vec2 normal;
+        bool begin;
     };
 
     struct scene_physics_data {
         std::unordered_map<entt::entity, entity_physics_data> bodies;
 
+        // entities whose physics-related components changed since the last sync
+        std::unordered_set<entt::entity> dirty;
+
         b2World* world;
         std::unique_ptr<b2ContactListener> listener;
-    };
 
-    class box2d_contact_listener : public b2ContactListener {
-    public:
-        static std::unique_ptr<b2ContactListener> create(ref<scene> _scene) {
-            auto instance = new box2d_contact_listener(_scene.raw());
-            return std::unique_ptr<b2ContactListener>(instance);
-        }
+        // transforms of the bodies that moved during the last step. the step writes into the back
+        // buffer, and the front buffer is applied to the scene at the sync point
+        std::vector<body_snapshot> front_snapshot, back_snapshot;
+        bool step_in_flight = false;
 
-        virtual void BeginContact(b2Contact* contact) override {
-            b2Fixture* fixture = contact->GetFixtureA();
-            uintptr_t user_data = fixture->GetUserData().pointer;
-            entity entity_a((entt::entity)(uint32_t)user_data, m_scene);
+        // only used when stepping on the physics thread
+        std::unique_ptr<physics_worker_data> worker;
+        std::vector<body_command> queued_commands;
 
-            fixture = contact->GetFixtureB();
-            user_data = fixture->GetUserData().pointer;
-            entity entity_b((entt::entity)(uint32_t)user_data, m_scene);
+        // contacts recorded while stepping. both vectors are kept around so that their storage is
+        // reused from frame to frame
+        std::vector<contact_event> contact_events, dispatched_events;
+    };
 
-            // native scripts
-            if (entity_a.has_all<native_script_component>()) {
-                auto& nsc = entity_a.get_component<native_script_component>();
-                if (nsc.script != nullptr) {
-                    nsc.script->on_collision(entity_b);
-                }
+    static void dispatch_contact_events(scene* _scene, scene_physics_data* data) {
+        // scripts may cause more contacts to be reported while dispatching; those stay queued until
+        // the next dispatch
+        auto& events = data->dispatched_events;
+        std::swap(events, data->contact_events);
+
+        std::stable_sort(events.begin(), events.end(),
+                         [](const contact_event& lhs, const contact_event& rhs) {
+                             return lhs._entity < rhs._entity;
+                         });
+
+        size_t group_start = 0;
+        while (group_start < events.size()) {
+            size_t group_end = group_start + 1;
+            while (group_end < events.size() &&
+                   events[group_end]._entity == events[group_start]._entity) {
+                group_end++;
             }
 
-            if (entity_b.has_all<native_script_component>()) {
-                auto& nsc = entity_b.get_component<native_script_component>();
-                if (nsc.script != nullptr) {
-                    nsc.script->on_collision(entity_a);
-                }
+            entity e(events[group_start]._entity, _scene);
+            if (!e || e.has_all<inactive_component>()) {
+                group_start = group_end;
+                continue;
+            }
+
+            entity_script* native_script = nullptr;
+            if (e.has_all<native_script_component>()) {
+                native_script = e.get_component<native_script_component>().script;
             }
 
-            // managed scripts
-            std::string event_name = "OnCollision(Entity)";
-            if (entity_a.has_all<script_component>()) {
-                m_scene->verify_script(entity_a);
+            void* instance = nullptr;
+            const script_callbacks* callbacks = nullptr;
+            if (e.has_all<script_component>()) {
+                _scene->verify_script(e);
 
-                auto& sc = entity_a.get_component<script_component>();
+                auto& sc = e.get_component<script_component>();
                 if (sc._class != nullptr && sc.enabled) {
-                    void* OnCollision = script_engine::get_method(sc._class, event_name);
+                    callbacks = &script_callback_cache::get(sc._class);
+                    instance = sc.instance->get();
+                }
+            }
 
-                    if (OnCollision != nullptr) {
-                        void* instance = sc.instance->get();
+            for (size_t i = group_start; i < group_end && e; i++) {
+                const auto& event = events[i];
 
-                        void* param = script_helpers::create_entity_object(entity_b);
-                        script_engine::call_method(instance, OnCollision, param);
-                    }
+                entity other(event.other, _scene);
+                if (!other || other.has_all<inactive_component>()) {
+                    continue;
                 }
-            }
 
-            if (entity_b.has_all<script_component>()) {
-                m_scene->verify_script(entity_b);
+                // native scripts
+                if (native_script != nullptr) {
+                    if (event.begin) {
+                        native_script->on_collision_begin(other, event.normal);
+                    } else {
+                        native_script->on_collision_end(other);
+                    }
+                }
 
-                auto& sc = entity_b.get_component<script_component>();
-                if (sc._class != nullptr && sc.enabled) {
-                    void* OnCollision = script_engine::get_method(sc._class, event_name);
+                // managed scripts
+                if (callbacks != nullptr) {
+                    void* method =
+                        event.begin ? callbacks->on_collision : callbacks->on_collision_end;
+                    if (method == nullptr) {
+                        continue;
+                    }
 
-                    if (OnCollision != nullptr) {
-                        void* instance = sc.instance->get();
+                    void* param = script_helpers::create_entity_object(other);
+                    if (event.begin && callbacks->collision_takes_normal) {
+                        glm::vec2 normal = event.normal;
+                        script_engine::call_method(instance, method, param, &normal);
+                    } else {
+                        void* thunk = event.begin ? callbacks->thunks.on_collision
+                                                  : callbacks->thunks.on_collision_end;
 
-                        void* param = script_helpers::create_entity_object(entity_a);
-                        script_engine::call_method(instance, OnCollision, param);
+                        script_engine::call_thunk(thunk, instance, param);
                     }
                 }
             }
+
+            group_start = group_end;
+        }
+
+        events.clear();
+    }
+
+    class box2d_contact_listener : public b2ContactListener {
+    public:
+        static std::unique_ptr<b2ContactListener> create(ref<scene> _scene) {
+            auto instance = new box2d_contact_listener(_scene.raw());
+            return std::unique_ptr<b2ContactListener>(instance);
         }
 
+        virtual void BeginContact(b2Contact* contact) override { record_contact(contact, true); }
+        virtual void EndContact(b2Contact* contact) override { record_contact(contact, false); }
+
     private:
         box2d_contact_listener(scene* _scene) { m_scene = _scene; }
 
+        // scripts are not called from within the step, as they may modify the world. contacts are
+        // queued and dispatched once the step has finished
+        void record_contact(b2Contact* contact, bool begin) {
+            b2Fixture* fixture = contact->GetFixtureA();
+            entt::entity entity_a = (entt::entity)(uint32_t)fixture->GetUserData().pointer;
+
+            fixture = contact->GetFixtureB();
+            entt::entity entity_b = (entt::entity)(uint32_t)fixture->GetUserData().pointer;
+
+            glm::vec2 normal = glm::vec2(0.f);
+            if (contact->GetManifold()->pointCount > 0) {
+                b2WorldManifold world_manifold;
+                contact->GetWorldManifold(&world_manifold);
+
+                normal = glm::vec2(world_manifold.normal.x, world_manifold.normal.y);
+            }
+
+            auto& events = m_scene->m_physics_data->contact_events;
+            events.push_back({ entity_a, entity_b, normal, begin });
+            events.push_back({ entity_b, entity_a, -normal, begin });
+        }
+
         scene* m_scene;
     };
 
@@ -170,7 +337,128 @@ namespace sge {
         return b2_staticBody;
     }
 
+    static void step_world(scene_physics_data* data, float ts) {
+        static constexpr int32_t velocity_iterations = 6;
+        static constexpr int32_t position_iterations = 2;
+        data->world->Step(ts, velocity_iterations, position_iterations);
+
+        // capture the transforms of bodies that could have moved
+        auto& snapshot = data->back_snapshot;
+        snapshot.clear();
+
+        for (const auto& [id, body_data] : data->bodies) {
+            b2Body* body = body_data.body;
+            if (body->GetType() == b2_staticBody || !body->IsAwake() || !body->IsEnabled()) {
+                continue;
+            }
+
+            body_snapshot& current = snapshot.emplace_back();
+            current.id = id;
+            current.position = body->GetPosition();
+            current.angle = body->GetAngle();
+        }
+    }
+
+    static void physics_thread(scene_physics_data* data) {
+        auto& worker = *data->worker;
+        while (true) {
+            float ts;
+            {
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                worker.condition.wait(lock, [&]() { return worker.quit || worker.step_pending; });
+
+                if (worker.quit) {
+                    break;
+                }
+
+                ts = worker.timestep;
+            }
+
+            step_world(data, ts);
+
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.step_pending = false;
+            }
+
+            worker.condition.notify_all();
+        }
+    }
+
+    static void stop_physics_worker(scene_physics_data* data) {
+        if (!data->worker) {
+            return;
+        }
+
+        auto& worker = *data->worker;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.quit = true;
+        }
+
+        worker.condition.notify_all();
+        worker.thread.join();
+
+        data->worker.reset();
+    }
+
+    static void destroy_physics_data(scene_physics_data* data) {
+        stop_physics_worker(data);
+        delete data->world;
+        delete data;
+    }
+
+    scene::scene() {
+        m_registry.on_construct<tag_component>().connect<&scene::on_tag_added>(*this);
+        m_registry.on_destroy<tag_component>().connect<&scene::on_tag_removed>(*this);
+
+        // changes made through patch or replace are synced with the body
+        m_registry.on_update<rigid_body_component>()
+            .connect<&scene::on_physics_component_updated>(*this);
+        m_registry.on_update<box_collider_component>()
+            .connect<&scene::on_physics_component_updated>(*this);
+        m_registry.on_update<circle_collider_component>()
+            .connect<&scene::on_physics_component_updated>(*this);
+        m_registry.on_update<shape_collider_component>()
+            .connect<&scene::on_physics_component_updated>(*this);
+
+        // events queued since the last frame are delivered first. delivery calls into scripts,
+        // which may create or destroy entities
+        m_systems.add_system("events", system_access().exclusive().main_thread(),
+                             [](scene& _scene, timestep ts) { _scene.dispatch_events(); });
+
+        // scripts can touch anything, so they run on their own. mono only runs managed code on
+        // threads attached to the domain, and native scripts are written against the main thread
+        m_systems.add_system("native_scripts", system_access().exclusive().main_thread(),
+                             [](scene& _scene, timestep ts) { _scene.update_native_scripts(ts); });
+
+        m_systems.add_system("managed_scripts", system_access().exclusive().main_thread(),
+                             [](scene& _scene, timestep ts) { _scene.update_managed_scripts(ts); });
+
+        // when threaded, the step runs while the scene is being rendered. the system itself stays
+        // on the main thread: it creates and destroys bodies, and collision callbacks are
+        // dispatched to scripts from it
+        m_systems.add_system("physics",
+                             system_access()
+                                 .read<rigid_body_component, box_collider_component,
+                                       circle_collider_component, shape_collider_component>()
+                                 .write<transform_component>()
+                                 .main_thread(),
+                             [](scene& _scene, timestep ts) { _scene.step_physics(ts); });
+
+        // the renderer keeps global batch state and isn't thread safe. finding the primary
+        // camera is a single view lookup, so it is done here rather than in a separate system
+        m_systems.add_system(
+            "render",
+            system_access()
+                .read<transform_component, camera_component, sprite_renderer_component>()
+                .main_thread(),
+            [](scene& _scene, timestep ts) { _scene.render_runtime(); });
+    }
+
     scene::~scene() {
+        reset_script_runner();
+
         {
             auto view = m_registry.view<native_script_component>();
             for (entt::entity id : view) {
@@ -191,9 +479,10 @@ namespace sge {
         }
 
         if (m_physics_data != nullptr) {
-            delete m_physics_data->world;
-            delete m_physics_data;
+            destroy_physics_data(m_physics_data);
         }
+
+        script_helpers::release_scene_objects(this);
     }
 
     entity scene::create_entity(const std::string& name) {
@@ -209,8 +498,7 @@ namespace sge {
         e.add_component<id_component>().id = id;
         e.add_component<transform_component>();
 
-        auto& t = e.add_component<tag_component>();
-        t.tag = name.empty() ? "Entity" : name;
+        e.add_component<tag_component>(name.empty() ? "Entity" : name);
 
         return e;
     }
@@ -240,12 +528,11 @@ namespace sge {
             }
         }
 
-        auto& dst_tag = dst.get_component<tag_component>();
         if (!name.empty()) {
-            dst_tag.tag = name;
+            set_tag(dst, name);
         } else {
             const auto& src_tag = src.get_component<tag_component>();
-            dst_tag.tag = src_tag.tag + " - Copy";
+            set_tag(dst, src_tag.tag.str() + " - Copy");
         }
 
         return dst;
@@ -267,11 +554,24 @@ namespace sge {
             e.remove_component<rigid_body_component>();
         }
 
-        if (m_physics_data != nullptr &&
-            m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-            update_physics_data(e);
+        if (m_physics_data != nullptr) {
+            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
+                update_physics_data(e);
+            }
+
+            m_physics_data->dirty.erase(e);
+        }
+
+        if (e.has_all<pooled_component, inactive_component>()) {
+            auto& pool = m_entity_pools[e.get_component<pooled_component>().source];
+            auto it = std::find(pool.available.begin(), pool.available.end(), (entt::entity)e);
+            if (it != pool.available.end()) {
+                pool.available.erase(it);
+            }
         }
 
+        m_event_subscriptions.unsubscribe_all(e);
+        script_helpers::release_entity_object(e);
         m_registry.destroy(e);
         recalculate_render_order();
     }
@@ -295,7 +595,15 @@ namespace sge {
             }
         }
 
+        destroy_bodies();
+
         m_registry.clear();
+        script_helpers::release_scene_objects(this);
+        m_tag_index.clear();
+        m_tag_positions.clear();
+        m_entity_pools.clear();
+        m_event_subscriptions.clear();
+        m_event_queues.clear();
         for (std::string& name : m_collision_category_names) {
             name.clear();
         }
@@ -308,6 +616,11 @@ namespace sge {
 
         remove_script(e);
         e.get_component<script_component>()._class = _class;
+
+        // resolved now rather than on the first frame the script runs
+        if (_class != nullptr) {
+            script_callback_cache::get(_class);
+        }
     }
 
     void scene::reset_script(entity e) {
@@ -344,6 +657,9 @@ namespace sge {
     }
 
     void scene::update_physics_data(entity e) {
+        // the world can't be modified while it is being stepped
+        wait_for_physics_step();
+
         if (e.has_all<rigid_body_component>()) {
             if (m_physics_data->bodies.find(e) == m_physics_data->bodies.end()) {
                 m_physics_data->bodies.insert(
@@ -372,6 +688,14 @@ namespace sge {
                 data.body->SetType(rigid_body_type_to_box2d_body(rb.type));
             }
 
+            set_synced_transform(data, transform);
+
+            // released pooled entities keep their bodies, but take no part in the simulation
+            bool enabled = !e.has_all<inactive_component>();
+            if (data.body->IsEnabled() != enabled) {
+                data.body->SetEnabled(enabled);
+            }
+
             auto type = get_collider_type(e);
             if (type != collider_type::shape) {
                 data.previous_shape.reset();
@@ -499,12 +823,253 @@ namespace sge {
         }
     }
 
-    static guid get_shader_guid(ref<shader> _shader) {
-        if (!_shader) {
-            return 0;
+    void scene::mark_physics_dirty(entity e) {
+        // bodies are only created while the scene is running
+        if (m_physics_data == nullptr) {
+            return;
+        }
+
+        m_physics_data->dirty.insert(e);
+    }
+
+    void scene::on_physics_component_updated(entt::registry& registry, entt::entity id) {
+        mark_physics_dirty(entity(id, this));
+    }
+
+    void scene::sync_physics_data() {
+        // anything can write to a transform, so transforms are compared instead of tracked
+        for (const auto& [id, data] : m_physics_data->bodies) {
+            const auto& transform = m_registry.get<transform_component>(id);
+            if (!is_transform_synced(data, transform)) {
+                m_physics_data->dirty.insert(id);
+            }
+        }
+
+        for (entt::entity id : m_physics_data->dirty) {
+            entity e(id, this);
+            if (e) {
+                update_physics_data(e);
+            }
+        }
+
+        m_physics_data->dirty.clear();
+    }
+
+    b2Body* scene::get_body(entity e) {
+        auto& bodies = m_physics_data->bodies;
+        auto& dirty = m_physics_data->dirty;
+
+        // make sure the body exists and reflects any pending changes
+        auto it = bodies.find(e);
+        if (it == bodies.end() || dirty.find(e) != dirty.end()) {
+            update_physics_data(e);
+            dirty.erase(e);
+
+            it = bodies.find(e);
+        }
+
+        return it != bodies.end() ? it->second.body : nullptr;
+    }
+
+    void scene::destroy_bodies() {
+        if (m_physics_data == nullptr) {
+            return;
+        }
+
+        wait_for_physics_step();
+        for (const auto& [id, data] : m_physics_data->bodies) {
+            m_physics_data->world->DestroyBody(data.body);
+        }
+
+        // results of an unfinished step refer to the destroyed bodies
+        m_physics_data->bodies.clear();
+        m_physics_data->dirty.clear();
+        m_physics_data->queued_commands.clear();
+        m_physics_data->contact_events.clear();
+        m_physics_data->step_in_flight = false;
+    }
+
+    struct body_state {
+        entt::entity id;
+        b2Vec2 position;
+        float angle;
+
+        b2Vec2 linear_velocity;
+        float angular_velocity;
+        bool awake;
+    };
+
+    void scene::write_body_states(snapshot_writer& writer) {
+        std::vector<body_state> states;
+        if (m_physics_data != nullptr) {
+            // iterate the storage rather than the body map, so that the order is stable
+            auto view = m_registry.view<rigid_body_component>();
+            for (entt::entity id : view) {
+                auto it = m_physics_data->bodies.find(id);
+                if (it == m_physics_data->bodies.end()) {
+                    continue;
+                }
+
+                b2Body* body = it->second.body;
+                body_state& state = states.emplace_back();
+
+                state.id = id;
+                state.position = body->GetPosition();
+                state.angle = body->GetAngle();
+                state.linear_velocity = body->GetLinearVelocity();
+                state.angular_velocity = body->GetAngularVelocity();
+                state.awake = body->IsAwake();
+            }
+        }
+
+        writer.write<uint64_t>(states.size());
+        for (const auto& state : states) {
+            writer.write(state);
+        }
+    }
+
+    void scene::read_body_states(snapshot_reader& reader) {
+        std::vector<body_state> states((size_t)reader.read<uint64_t>());
+        for (auto& state : states) {
+            state = reader.read<body_state>();
+        }
+
+        if (m_physics_data == nullptr) {
+            return;
+        }
+
+        auto view = m_registry.view<rigid_body_component>();
+        m_physics_data->dirty.insert(view.begin(), view.end());
+        sync_physics_data();
+
+        for (const auto& state : states) {
+            auto it = m_physics_data->bodies.find(state.id);
+            if (it == m_physics_data->bodies.end()) {
+                continue;
+            }
+
+            b2Body* body = it->second.body;
+            body->SetTransform(state.position, state.angle);
+            body->SetLinearVelocity(state.linear_velocity);
+            body->SetAngularVelocity(state.angular_velocity);
+            body->SetAwake(state.awake);
+        }
+    }
+
+    void scene::wait_for_physics_step() {
+        if (m_physics_data == nullptr || !m_physics_data->worker) {
+            return;
+        }
+
+        auto& worker = *m_physics_data->worker;
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.condition.wait(lock, [&]() { return !worker.step_pending; });
+    }
+
+    void scene::step_physics(timestep ts) {
+        // sync point - the world is idle, so pending changes can be applied
+        sync_physics_data();
+
+        for (const auto& command : m_physics_data->queued_commands) {
+            entity e(command.id, this);
+            if (!e || !e.has_all<rigid_body_component>()) {
+                continue;
+            }
+
+            b2Body* body = get_body(e);
+            if (body != nullptr) {
+                execute_body_command(body, command);
+            }
+        }
+
+        m_physics_data->queued_commands.clear();
+        m_physics_data->step_in_flight = true;
+
+        if (!m_threaded_physics) {
+            // the thread isn't needed anymore if threading was turned off
+            stop_physics_worker(m_physics_data);
+
+            step_world(m_physics_data, (float)ts.count());
+            finish_physics_step();
+
+            return;
+        }
+
+        auto& worker = m_physics_data->worker;
+        if (!worker) {
+            worker = std::make_unique<physics_worker_data>();
+            worker->thread = std::thread(physics_thread, m_physics_data);
+            environment::set_thread_name(worker->thread, "physics");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->timestep = (float)ts.count();
+            worker->step_pending = true;
+        }
+
+        worker->condition.notify_all();
+    }
+
+    void scene::finish_physics_step() {
+        if (!m_physics_data->step_in_flight) {
+            return;
+        }
+
+        wait_for_physics_step();
+        m_physics_data->step_in_flight = false;
+
+        auto& snapshot = m_physics_data->front_snapshot;
+        std::swap(snapshot, m_physics_data->back_snapshot);
+
+        for (const auto& current : snapshot) {
+            // destroyed or changed since the step began
+            auto it = m_physics_data->bodies.find(current.id);
+            if (it == m_physics_data->bodies.end() ||
+                m_physics_data->dirty.find(current.id) != m_physics_data->dirty.end()) {
+                continue;
+            }
+
+            auto& transform = m_registry.get<transform_component>(current.id);
+            if (!is_transform_synced(it->second, transform)) {
+                m_physics_data->dirty.insert(current.id);
+                continue;
+            }
+
+            transform.translation.x = current.position.x;
+            transform.translation.y = current.position.y;
+            transform.rotation = glm::degrees(current.angle);
+            set_synced_transform(it->second, transform);
+        }
+
+        dispatch_contact_events(this, m_physics_data);
+    }
+
+    bool scene::apply_body_command(entity e, body_command& command) {
+        // bodies only exist while the scene is running
+        if (m_physics_data == nullptr || !e.has_all<rigid_body_component>()) {
+            return false;
+        }
+
+        if (m_physics_data->step_in_flight) {
+            // the physics thread owns the world; apply at the next sync point
+            command.id = (entt::entity)e;
+            m_physics_data->queued_commands.push_back(command);
+        } else {
+            b2Body* body = get_body(e);
+            if (body == nullptr) {
+                return false;
+            }
+
+            execute_body_command(body, command);
         }
 
-        return _shader->id;
+        return true;
+    }
+
+    // sprites are grouped by shader, as switching shaders breaks the batch
+    static guid get_shader_guid(const sprite_renderer_component& sprite) {
+        return material_table::get(sprite.material).shader_id;
     }
 
     void scene::recalculate_render_order() {
@@ -520,6 +1085,10 @@ namespace sge {
 
         std::vector<entity> entities;
         for (auto _entity : group) {
+            if (m_registry.all_of<inactive_component>(_entity)) {
+                continue;
+            }
+
             const auto& [transform, sprite] =
                 group.get<transform_component, sprite_renderer_component>(_entity);
 
@@ -528,7 +1097,7 @@ namespace sge {
             }
 
             auto& shader_indices = z_layers[transform.z_layer];
-            guid id = get_shader_guid(sprite._shader);
+            guid id = get_shader_guid(sprite);
 
             if (shader_indices.find(id) == shader_indices.end()) {
                 shader_indices.insert(std::make_pair(id, 0));
@@ -541,7 +1110,7 @@ namespace sge {
             const auto& transform = _entity.get_component<transform_component>();
             const auto& sprite = _entity.get_component<sprite_renderer_component>();
 
-            guid id = get_shader_guid(sprite._shader);
+            guid id = get_shader_guid(sprite);
             size_t insert_index = z_layers[transform.z_layer][id];
 
             {
@@ -566,84 +1135,58 @@ namespace sge {
     }
 
     bool scene::apply_force(entity e, glm::vec2 force, glm::vec2 point, bool wake) {
-        if (!e.has_all<rigid_body_component>()) {
-            return false;
-        }
-
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
-        // apply the force
-        b2Vec2 b2_force(force.x, force.y);
-        b2Vec2 b2_point(point.x, point.y);
-        m_physics_data->bodies[e].body->ApplyForce(b2_force, b2_point, wake);
+        body_command command;
+        command.type = body_command_type::force;
+        command.vector.Set(force.x, force.y);
+        command.point.Set(point.x, point.y);
+        command.wake = wake;
 
-        return true;
+        return apply_body_command(e, command);
     }
 
     bool scene::apply_force(entity e, glm::vec2 force, bool wake) {
-        if (!e.has_all<rigid_body_component>()) {
-            return false;
-        }
-
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
+        body_command command;
+        command.type = body_command_type::force_to_center;
+        command.vector.Set(force.x, force.y);
+        command.wake = wake;
 
-        // apply the force
-        b2Vec2 b2_force(force.x, force.y);
-        m_physics_data->bodies[e].body->ApplyForceToCenter(b2_force, wake);
-
-        return true;
+        return apply_body_command(e, command);
     }
 
     bool scene::apply_linear_impulse(entity e, glm::vec2 impulse, glm::vec2 point, bool wake) {
-        if (!e.has_all<rigid_body_component>()) {
-            return false;
-        }
+        body_command command;
+        command.type = body_command_type::linear_impulse;
+        command.vector.Set(impulse.x, impulse.y);
+        command.point.Set(point.x, point.y);
+        command.wake = wake;
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
-        // apply the impulse
-        b2Vec2 b2_impulse(impulse.x, impulse.y);
-        b2Vec2 b2_point(point.x, point.y);
-        m_physics_data->bodies[e].body->ApplyLinearImpulse(b2_impulse, b2_point, wake);
-
-        return true;
+        return apply_body_command(e, command);
     }
 
     bool scene::apply_linear_impulse(entity e, glm::vec2 impulse, bool wake) {
-        if (!e.has_all<rigid_body_component>()) {
-            return false;
-        }
+        body_command command;
+        command.type = body_command_type::linear_impulse_to_center;
+        command.vector.Set(impulse.x, impulse.y);
+        command.wake = wake;
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
+        return apply_body_command(e, command);
+    }
 
-        // apply the impulse
-        b2Vec2 b2_impulse(impulse.x, impulse.y);
-        m_physics_data->bodies[e].body->ApplyLinearImpulseToCenter(b2_impulse, wake);
+    bool scene::apply_torque(entity e, float torque, bool wake) {
+        body_command command;
+        command.type = body_command_type::torque;
+        command.scalar = torque;
+        command.wake = wake;
 
-        return true;
-    }
-
-    bool scene::apply_torque(entity e, float torque, bool wake) {
-        if (!e.has_all<rigid_body_component>()) {
-            return false;
-        }
-
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
-        // apply the torque
-        m_physics_data->bodies[e].body->ApplyTorque(torque, wake);
-        return true;
+        return apply_body_command(e, command);
     }
 
     std::optional<glm::vec2> scene::get_velocity(entity e) {
         std::optional<glm::vec2> velocity;
 
-        if (e.has_all<rigid_body_component>()) {
+        if (m_physics_data != nullptr && e.has_all<rigid_body_component>()) {
+            wait_for_physics_step();
+
             if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
                 b2Body* body = m_physics_data->bodies[e].body;
 
@@ -656,22 +1199,19 @@ namespace sge {
     }
 
     bool scene::set_velocity(entity e, glm::vec2 velocity) {
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-                body->SetLinearVelocity(b2Vec2(velocity.x, velocity.y));
+        body_command command;
+        command.type = body_command_type::linear_velocity;
+        command.vector.Set(velocity.x, velocity.y);
 
-                return true;
-            }
-        }
-
-        return false;
+        return apply_body_command(e, command);
     }
 
     std::optional<float> scene::get_angular_velocity(entity e) {
         std::optional<float> velocity;
 
-        if (e.has_all<rigid_body_component>()) {
+        if (m_physics_data != nullptr && e.has_all<rigid_body_component>()) {
+            wait_for_physics_step();
+
             if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
                 b2Body* body = m_physics_data->bodies[e].body;
                 velocity = body->GetAngularVelocity();
@@ -682,16 +1222,11 @@ namespace sge {
     }
 
     bool scene::set_angular_velocity(entity e, float velocity) {
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-                body->SetAngularVelocity(velocity);
+        body_command command;
+        command.type = body_command_type::angular_velocity;
+        command.scalar = velocity;
 
-                return true;
-            }
-        }
-
-        return false;
+        return apply_body_command(e, command);
     }
 
     entity scene::find_guid(guid id) {
@@ -711,32 +1246,143 @@ namespace sge {
         return found;
     }
 
-    ref<scene> scene::copy() {
-        auto new_scene = ref<scene>::create();
-        new_scene->m_collision_category_names = m_collision_category_names;
-        new_scene->m_render_colliders = m_render_colliders;
+    void scene::set_tag(entity e, const std::string& tag) {
+        if (!e.has_all<tag_component>()) {
+            e.add_component<tag_component>(tag);
+            return;
+        }
+
+        on_tag_removed(m_registry, e);
+        e.get_component<tag_component>().tag = tag;
+        on_tag_added(m_registry, e);
+    }
 
-        // Map from the entt entity id in the old scene to the new scene
-        std::unordered_map<entt::entity, entt::entity> entity_map;
+    entity scene::find_tag(const std::string& tag) {
+        auto tagged = get_tagged(tag);
+        if (tagged == nullptr || tagged->empty()) {
+            return entity();
+        }
 
-        // Create corresponding entities (without components) in the new scene. Make sure guid and
-        // tag match.  Also store map from id to new entity in entity map.
-        {
-            auto view = m_registry.view<id_component, tag_component>();
-            for (entt::entity id : view) {
-                entity original(id, this);
-                guid entity_id = original.get_guid();
-                const std::string& tag = original.get_component<tag_component>().tag;
+        return entity(tagged->front(), this);
+    }
+
+    std::vector<entity> scene::find_all_tagged(const std::string& tag) {
+        std::vector<entity> entities;
 
-                entity new_entity = new_scene->create_entity(entity_id, tag);
-                entity_map.insert(std::make_pair(id, (entt::entity)new_entity));
+        auto tagged = get_tagged(tag);
+        if (tagged != nullptr) {
+            for (auto id : *tagged) {
+                entities.push_back(entity(id, this));
             }
         }
 
-        // Loop over every component type in source scene
+        return entities;
+    }
+
+    const std::vector<entt::entity>* scene::get_tagged(const std::string& tag) {
+        // strings that were never interned can't be anyone's tag
+        auto handle = string_pool::find(tag);
+        if (!handle.has_value()) {
+            return nullptr;
+        }
+
+        auto it = m_tag_index.find(handle.value());
+        if (it == m_tag_index.end()) {
+            return nullptr;
+        }
+
+        return &it->second;
+    }
+
+    void scene::on_tag_added(entt::registry& registry, entt::entity id) {
+        auto handle = registry.get<tag_component>(id).tag.get_handle();
+        auto& tagged = m_tag_index[handle];
+
+        m_tag_positions[id] = tagged.size();
+        tagged.push_back(id);
+    }
+
+    void scene::on_tag_removed(entt::registry& registry, entt::entity id) {
+        auto handle = registry.get<tag_component>(id).tag.get_handle();
+
+        auto it = m_tag_index.find(handle);
+        if (it == m_tag_index.end()) {
+            return;
+        }
+
+        auto position_it = m_tag_positions.find(id);
+        if (position_it == m_tag_positions.end()) {
+            return;
+        }
+
+        // swap with the last entity, so that removing many tagged entities stays linear
+        auto& tagged = it->second;
+        size_t position = position_it->second;
+        m_tag_positions.erase(position_it);
+
+        if (position + 1 < tagged.size()) {
+            entt::entity last = tagged.back();
+            tagged[position] = last;
+            m_tag_positions[last] = position;
+        }
+
+        tagged.pop_back();
+        if (tagged.empty()) {
+            m_tag_index.erase(it);
+        }
+    }
+
+    template <typename T>
+    static void copy_storage(entt::registry& src, entt::registry& dst,
+                             std::unordered_set<entt::id_type>& copied_types) {
+        auto& storage = src.storage<T>();
+        const entt::sparse_set& entities = storage;
+
+        // entity and component arrays are laid out in the same order
+        if constexpr (std::is_empty_v<T>) {
+            dst.insert<T>(entities.begin(), entities.end());
+        } else {
+            dst.insert<T>(entities.begin(), entities.end(), storage.begin());
+        }
+        copied_types.insert(entt::type_id<T>().hash());
+    }
+
+    template <typename... T>
+    static void copy_storages(entt::registry& src, entt::registry& dst,
+                              std::unordered_set<entt::id_type>& copied_types) {
+        (copy_storage<T>(src, dst, copied_types), ...);
+    }
+
+    ref<scene> scene::copy() {
+        auto new_scene = ref<scene>::create();
+        new_scene->m_collision_category_names = m_collision_category_names;
+        new_scene->m_render_colliders = m_render_colliders;
+        new_scene->m_threaded_physics = m_threaded_physics;
+        new_scene->m_batched_scripts = m_batched_scripts;
+        new_scene->m_systems.copy_systems(m_systems);
+
+        // Create the entities in the new scene with the same identifiers, so that components can be
+        // copied storage-by-storage without remapping
+        auto& registry = new_scene->m_registry;
+        m_registry.each([&](entt::entity id) { registry.create(id); });
+
+        // Components that hold no state tied to their scene are copied in bulk. The component
+        // hooks aren't invoked, so the render order and camera sizes are fixed up below, and
+        // physics bodies are created when the scene starts
+        std::unordered_set<entt::id_type> copied_types;
+        copy_storages<id_component, tag_component, transform_component, sprite_renderer_component,
+                      camera_component, rigid_body_component, box_collider_component,
+                      circle_collider_component, shape_collider_component, pooled_component,
+                      inactive_component>(m_registry, registry, copied_types);
+
+        // Everything else is cloned through the meta "clone" function
         for (auto&& [id_type, storage] : m_registry.storage()) {
             using namespace entt::literals;
 
+            if (copied_types.find(id_type) != copied_types.end()) {
+                continue;
+            }
+
             // Only iterate over the entities in the storage pool if that type supports cloning.
             auto type = entt::resolve(storage.type());
             if (!type) {
@@ -746,7 +1392,7 @@ namespace sge {
             if (auto clone = type.func("clone"_hs); clone) {
                 for (auto&& e : storage) {
                     auto srce = entity{ e, this };
-                    auto dste = entity{ entity_map.at(e), new_scene.raw() };
+                    auto dste = entity{ e, new_scene.raw() };
 
                     auto raw = storage.get(e);
                     if (!clone.invoke({}, entt::forward_as_meta(srce), entt::forward_as_meta(dste),
@@ -757,10 +1403,118 @@ namespace sge {
             }
         }
 
+        // entity identifiers are the same in both scenes
+        new_scene->m_entity_pools = m_entity_pools;
+
+        new_scene->m_render_order.reserve(m_render_order.size());
+        for (entity e : m_render_order) {
+            new_scene->m_render_order.push_back(entity(e, new_scene.raw()));
+        }
+
         new_scene->set_viewport_size(m_viewport_width, m_viewport_height);
         return new_scene;
     }
 
+    entity scene::instantiate_pooled(ref<prefab> _prefab) {
+        auto& pool = m_entity_pools[_prefab.raw()];
+        if (pool.available.empty()) {
+            pool.source = _prefab;
+
+            entity e = _prefab->instantiate(this);
+            auto& pooled = e.add_component<pooled_component>();
+            pooled.source = _prefab.raw();
+            pooled.initial_transform = e.get_component<transform_component>();
+
+            return e;
+        }
+
+        entity e(pool.available.back(), this);
+        pool.available.pop_back();
+        m_registry.remove<inactive_component>(e);
+
+        // start over from the state the prefab was instantiated with
+        auto& transform = e.get_component<transform_component>();
+        transform = e.get_component<pooled_component>().initial_transform;
+
+        if (e.has_all<rigid_body_component>()) {
+            mark_physics_dirty(e);
+
+            set_velocity(e, glm::vec2(0.f));
+            set_angular_velocity(e, 0.f);
+        }
+
+        // managed scripts get a new instance, so that no state is left over from the last use
+        if (e.has_all<script_component>()) {
+            e.get_component<script_component>().instance.reset();
+            verify_script(e);
+        }
+
+        if (e.has_all<sprite_renderer_component>()) {
+            insert_into_render_order(e);
+        }
+
+        return e;
+    }
+
+    void scene::release_entity(entity e) {
+        if (!e.has_all<pooled_component>()) {
+            destroy_entity(e);
+            return;
+        }
+
+        if (e.has_all<inactive_component>()) {
+            return;
+        }
+
+        m_registry.emplace<inactive_component>(e);
+        unregister_batched_script(e);
+        m_entity_pools[e.get_component<pooled_component>().source].available.push_back(e);
+
+        // the body is disabled on the next sync
+        if (e.has_all<rigid_body_component>()) {
+            mark_physics_dirty(e);
+        }
+
+        auto it = std::find(m_render_order.begin(), m_render_order.end(), e);
+        if (it != m_render_order.end()) {
+            m_render_order.erase(it);
+        }
+    }
+
+    bool scene::is_entity_active(entity e) { return !e.has_all<inactive_component>(); }
+
+    void scene::insert_into_render_order(entity e) {
+        const auto& transform = e.get_component<transform_component>();
+        guid shader_id = get_shader_guid(e.get_component<sprite_renderer_component>());
+
+        // after the last entity on the same layer using the same shader, or otherwise before the
+        // first entity on a higher layer
+        std::optional<size_t> insert_index;
+        for (size_t i = 0; i < m_render_order.size(); i++) {
+            entity current = m_render_order[i];
+            int32_t z_layer = current.get_component<transform_component>().z_layer;
+
+            if (z_layer > transform.z_layer) {
+                if (!insert_index.has_value()) {
+                    insert_index = i;
+                }
+
+                break;
+            }
+
+            if (z_layer == transform.z_layer) {
+                const auto& sprite = current.get_component<sprite_renderer_component>();
+                if (get_shader_guid(sprite) == shader_id) {
+                    insert_index = i + 1;
+                }
+            }
+        }
+
+        auto it = m_render_order.begin();
+        std::advance(it, insert_index.value_or(m_render_order.size()));
+        m_render_order.insert(it, e);
+    }
+
     void scene::on_start() {
         // Initialize the box2d physics engine
         {
@@ -769,6 +1523,10 @@ namespace sge {
 
             m_physics_data->listener = box2d_contact_listener::create(this);
             m_physics_data->world->SetContactListener(m_physics_data->listener.get());
+
+            // every body needs to be created on the first update
+            auto view = m_registry.view<rigid_body_component>();
+            m_physics_data->dirty.insert(view.begin(), view.end());
         }
 
         // Call OnStart method, if it exists
@@ -783,10 +1541,10 @@ namespace sge {
                     continue;
                 }
 
-                void* OnStart = script_engine::get_method(sc._class, "OnStart()");
+                void* OnStart = script_callback_cache::get(sc._class).thunks.on_start;
                 if (OnStart != nullptr) {
                     void* instance = sc.instance->get();
-                    script_engine::call_method(instance, OnStart);
+                    script_engine::call_thunk(OnStart, instance);
                 }
             }
         }
@@ -805,129 +1563,249 @@ namespace sge {
                     continue;
                 }
 
-                void* OnStop = script_engine::get_method(sc._class, "OnStop()");
+                void* OnStop = script_callback_cache::get(sc._class).thunks.on_stop;
                 if (OnStop != nullptr) {
                     void* instance = sc.instance->get();
-                    script_engine::call_method(instance, OnStop);
+                    script_engine::call_thunk(OnStop, instance);
                 }
             }
         }
 
         // Delete physics data
-        delete m_physics_data->world;
-        delete m_physics_data;
+        destroy_physics_data(m_physics_data);
         m_physics_data = nullptr;
+
+        reset_script_runner();
+        m_event_queues.clear();
     }
 
     void scene::on_runtime_update(timestep ts) {
-        // Native Scripts
-        {
-            auto view = m_registry.view<native_script_component>();
-            for (auto id : view) {
-                entity entity(id, this);
-                auto& nsc = entity.get_component<native_script_component>();
+        // Collect the results of the step started last frame, if the physics thread is in use
+        finish_physics_step();
 
-                if (nsc.script == nullptr && nsc.instantiate != nullptr) {
-                    nsc.instantiate(&nsc, entity);
-                }
+        m_systems.run(*this, m_registry, ts);
+    }
 
-                if (nsc.script != nullptr) {
-                    nsc.script->on_update(ts);
-                }
+    void scene::update_native_scripts(timestep ts) {
+        auto view = m_registry.view<native_script_component>(entt::exclude<inactive_component>);
+        for (auto id : view) {
+            auto& nsc = view.get<native_script_component>(id);
+            if (nsc.script == nullptr && nsc.instantiate != nullptr) {
+                nsc.instantiate(&nsc, entity(id, this));
+            }
+
+            if (nsc.script != nullptr) {
+                nsc.script->on_update(ts);
             }
         }
+    }
 
-        // Managed Scripts
-        {
-            auto view = m_registry.view<script_component>();
-            for (auto id : view) {
-                entity e(id, this);
-                if (!e) {
-                    continue;
-                }
+    // state of the managed SGE.ScriptRunner of a scene
+    struct script_runner_data {
+        ref<object_ref> runner;
+        void* update_method;
+        void* remove_method;
 
-                verify_script(e);
-                auto& sc = e.get_component<script_component>();
-                if (sc._class == nullptr || !sc.enabled) {
-                    continue;
-                }
+        // the instance each entity was registered with, so that replaced scripts are noticed
+        std::unordered_map<entt::entity, ref<object_ref>> registered;
 
-                void* OnUpdate = script_engine::get_method(sc._class, "OnUpdate(Timestep)");
-                if (OnUpdate != nullptr) {
-                    void* instance = sc.instance->get();
+        // registrations that haven't been passed to the runner yet
+        std::vector<entt::entity> removed, added;
+    };
 
-                    double timestep_data = ts.count();
-                    script_engine::call_method(instance, OnUpdate, &timestep_data);
-                }
+    static void* create_uint_array(const std::vector<entt::entity>& ids) {
+        void* uint_class = script_helpers::get_core_type("System.UInt32");
+        void* array = script_engine::create_array(uint_class, ids.size());
+
+        for (size_t i = 0; i < ids.size(); i++) {
+            uint32_t id = (uint32_t)ids[i];
+            script_engine::set_array_element(array, i, &id);
+        }
+
+        return array;
+    }
+
+    void scene::reset_script_runner() {
+        delete m_script_runner;
+        m_script_runner = nullptr;
+    }
+
+    void scene::unregister_batched_script(entity e) {
+        if (m_script_runner == nullptr) {
+            return;
+        }
+
+        auto& data = *m_script_runner;
+        if (data.registered.erase(e) == 0) {
+            return;
+        }
+
+        // the runner must not call into a script whose entity is gone, even later this frame
+        void* runner = data.runner->get();
+        if (runner != nullptr) {
+            uint32_t id = (uint32_t)(entt::entity)e;
+            script_engine::call_method(runner, data.remove_method, &id);
+        }
+    }
+
+    void scene::update_batched_scripts(timestep ts) {
+        if (m_script_runner != nullptr && m_script_runner->runner->get() == nullptr) {
+            reset_script_runner();
+        }
+
+        if (m_script_runner == nullptr) {
+            void* runner_class = script_helpers::get_core_type("SGE.ScriptRunner", true);
+            void* runner = script_engine::alloc_object(runner_class);
+            script_engine::init_object(runner);
+
+            m_script_runner = new script_runner_data;
+            m_script_runner->runner = object_ref::from_object(runner);
+            m_script_runner->update_method = script_engine::get_method(runner_class, "Update");
+            m_script_runner->remove_method = script_engine::get_method(runner_class, "Remove");
+        }
+
+        auto& data = *m_script_runner;
+
+        // scripts that were replaced, disabled, or deactivated since the last frame
+        for (auto it = data.registered.begin(); it != data.registered.end();) {
+            entity e(it->first, this);
+
+            bool valid = e && e.has_all<script_component>() && !e.has_all<inactive_component>();
+            if (valid) {
+                const auto& sc = e.get_component<script_component>();
+                valid = sc.enabled && sc.instance == it->second;
+            }
+
+            if (valid) {
+                it++;
+            } else {
+                data.removed.push_back(it->first);
+                it = data.registered.erase(it);
             }
         }
 
-        // Physics
-        {
-            // update physics data for every entity in the scene
-            for_each([this](entity e) { update_physics_data(e); });
+        auto view = m_registry.view<script_component>(entt::exclude<inactive_component>);
+        for (auto id : view) {
+            entity e(id, this);
+            verify_script(e);
 
-            // update physics world
-            static constexpr int32_t velocity_iterations = 6;
-            static constexpr int32_t position_iterations = 2;
-            m_physics_data->world->Step(ts.count(), velocity_iterations, position_iterations);
+            auto& sc = e.get_component<script_component>();
+            if (sc._class == nullptr || !sc.enabled ||
+                data.registered.find(id) != data.registered.end()) {
+                continue;
+            }
 
-            // sync position data
-            auto view = m_registry.view<transform_component, rigid_body_component>();
-            for (entt::entity id : view) {
-                entity e(id, this);
-                auto& transform = e.get_component<transform_component>();
+            // scripts without OnUpdate are left out of the runner entirely
+            if (script_callback_cache::get(sc._class).on_update != nullptr) {
+                data.registered.insert(std::make_pair(id, sc.instance));
+                data.added.push_back(id);
+            }
+        }
 
-                if (m_physics_data->bodies.find(e) == m_physics_data->bodies.end()) {
-                    continue;
+        void* removed = nullptr;
+        if (!data.removed.empty()) {
+            removed = create_uint_array(data.removed);
+            data.removed.clear();
+        }
+
+        void* added_ids = nullptr;
+        void* added = nullptr;
+        if (!data.added.empty()) {
+            added_ids = create_uint_array(data.added);
+
+            void* script_class = script_helpers::get_core_type("SGE.Script", true);
+            added = script_engine::create_array(script_class, data.added.size());
+
+            for (size_t i = 0; i < data.added.size(); i++) {
+                const auto& instance = data.registered[data.added[i]];
+                script_engine::set_array_element(added, i, instance->get());
+            }
+
+            data.added.clear();
+        }
+
+        double timestep_data = ts.count();
+        script_engine::call_method(data.runner->get(), data.update_method, &timestep_data,
+                                   removed, added_ids, added);
+    }
+
+    void scene::update_managed_scripts(timestep ts) {
+        if (m_batched_scripts) {
+            update_batched_scripts(ts);
+            return;
+        }
+
+        // running unbatched, so the runner would fall out of date
+        reset_script_runner();
+
+        // thunks take value types boxed, so the timestep is boxed once for every script
+        ref<object_ref> boxed_timestep;
+
+        auto view = m_registry.view<script_component>(entt::exclude<inactive_component>);
+        for (auto id : view) {
+            entity e(id, this);
+            if (!e) {
+                continue;
+            }
+
+            verify_script(e);
+            auto& sc = e.get_component<script_component>();
+            if (sc._class == nullptr || !sc.enabled) {
+                continue;
+            }
+
+            void* OnUpdate = script_callback_cache::get(sc._class).thunks.on_update;
+            if (OnUpdate != nullptr) {
+                if (!boxed_timestep) {
+                    void* timestep_class = script_helpers::get_core_type("SGE.Timestep", true);
+                    double timestep_data = ts.count();
+
+                    void* boxed = script_engine::box_value(timestep_class, &timestep_data);
+                    boxed_timestep = object_ref::from_object(boxed);
                 }
 
-                b2Body* body = m_physics_data->bodies[e].body;
-                const auto& position = body->GetPosition();
-                transform.translation.x = position.x;
-                transform.translation.y = position.y;
-                transform.rotation = glm::degrees(body->GetAngle());
+                void* instance = sc.instance->get();
+                script_engine::call_thunk(OnUpdate, instance, boxed_timestep->get());
             }
         }
+    }
 
-        // Render
+    void scene::render_runtime() {
+        runtime_camera* main_camera = nullptr;
+        glm::mat4 camera_transform;
         {
-            runtime_camera* main_camera = nullptr;
-            glm::mat4 camera_transform;
-            {
-                auto view = m_registry.view<transform_component, camera_component>();
-                for (entt::entity id : view) {
-                    const auto& [camera_data, transform] =
-                        m_registry.get<camera_component, transform_component>(id);
-
-                    if (camera_data.primary) {
-                        main_camera = &camera_data.camera;
-                        camera_transform = transform.get_transform();
-                        break;
-                    }
+            auto view = m_registry.view<transform_component, camera_component>();
+            for (entt::entity id : view) {
+                const auto& [camera_data, transform] =
+                    m_registry.get<camera_component, transform_component>(id);
+
+                if (camera_data.primary) {
+                    main_camera = &camera_data.camera;
+                    camera_transform = transform.get_transform();
+                    break;
                 }
             }
+        }
 
-            glm::mat4 view_projection;
-            if (main_camera != nullptr) {
-                glm::mat4 projection = main_camera->get_projection();
-                view_projection = projection * glm::inverse(camera_transform);
-            } else {
-                static constexpr float default_view_size = 10.f;
-                float aspect_ratio = (float)m_viewport_width / (float)m_viewport_height;
+        glm::mat4 view_projection;
+        if (main_camera != nullptr) {
+            glm::mat4 projection = main_camera->get_projection();
+            view_projection = projection * glm::inverse(camera_transform);
+        } else {
+            static constexpr float default_view_size = 10.f;
+            float aspect_ratio = (float)m_viewport_width / (float)m_viewport_height;
 
-                float left = -default_view_size * aspect_ratio / 2.f;
-                float right = default_view_size * aspect_ratio / 2.f;
-                float bottom = -default_view_size / 2.f;
-                float top = default_view_size / 2.f;
+            float left = -default_view_size * aspect_ratio / 2.f;
+            float right = default_view_size * aspect_ratio / 2.f;
+            float bottom = -default_view_size / 2.f;
+            float top = default_view_size / 2.f;
 
-                view_projection = glm::ortho(left, right, bottom, top, -1.f, 1.f);
-            }
-
-            renderer::begin_scene(view_projection);
-            render();
-            renderer::end_scene();
+            view_projection = glm::ortho(left, right, bottom, top, -1.f, 1.f);
         }
+
+        renderer::begin_scene(view_projection);
+        render();
+        renderer::end_scene();
     }
 
     void scene::on_editor_update(timestep ts, const editor_camera& camera) {
@@ -967,65 +1845,96 @@ namespace sge {
     }
 
     void scene::on_event(event& e) {
-        // native scripts
-        {
-            auto view = m_registry.view<native_script_component>();
-            for (auto entt_entity : view) {
-                if (e.handled) {
-                    break;
-                }
+        // delivered to subscribers once per frame
+        m_event_queues.push(e);
+    }
 
-                entity entity(entt_entity, this);
-                auto& nsc = entity.get_component<native_script_component>();
+    void scene::subscribe_event(entity e, event_id id) { m_event_subscriptions.subscribe(e, id); }
 
-                if (nsc.script == nullptr && nsc.instantiate != nullptr) {
-                    nsc.instantiate(&nsc, entity);
-                }
+    void scene::unsubscribe_event(entity e, event_id id) {
+        m_event_subscriptions.unsubscribe(e, id);
+    }
 
-                if (nsc.script != nullptr) {
-                    nsc.script->on_event(e);
+    void scene::dispatch_events() {
+        m_event_queues.for_each([this](event_id id, event_queue_base& queue) {
+            // native scripts. scripts may change their subscriptions while handling events
+            auto subscribers = m_event_subscriptions.get_subscribers(id);
+
+            // scripts that never subscribed to anything receive every event
+            auto native_view = m_registry.view<native_script_component>();
+            for (entt::entity script_entity : native_view) {
+                if (!m_event_subscriptions.has_subscriptions(script_entity)) {
+                    subscribers.push_back(script_entity);
                 }
             }
-        }
-
-        // managed scripts
-        {
-            ref<object_ref> event_handle;
+            for (entt::entity subscriber : subscribers) {
+                auto nsc = m_registry.try_get<native_script_component>(subscriber);
+                if (nsc == nullptr || nsc->script == nullptr ||
+                    m_registry.all_of<inactive_component>(subscriber)) {
+                    continue;
+                }
 
-            auto view = m_registry.view<script_component>();
-            for (entt::entity id : view) {
-                if (e.handled) {
-                    break;
+                for (size_t i = 0; i < queue.size(); i++) {
+                    nsc->script->on_event(queue.get(i));
                 }
+            }
+
+            // managed scripts receive every event of the type in one call, if they can
+            ref<object_ref> events_handle;
+            uint32_t id_bit = 1u << (uint32_t)id;
 
-                entity current(id, this);
-                auto& sc = current.get_component<script_component>();
+            auto view = m_registry.view<script_component>(entt::exclude<inactive_component>);
+            for (entt::entity subscriber : view) {
+                auto& sc = view.get<script_component>(subscriber);
                 if (sc._class == nullptr || !sc.enabled) {
                     continue;
                 }
 
-                static const std::string event_name = "OnEvent(Event)";
-                void* OnEvent = script_engine::get_method(sc._class, event_name);
-                if (OnEvent == nullptr) {
+                const auto& callbacks = script_callback_cache::get(sc._class);
+                if ((callbacks.event_mask & id_bit) == 0) {
                     continue;
                 }
 
-                if (!event_handle) {
-                    void* event_instance = script_helpers::create_event_object(e);
-                    if (event_instance == nullptr) {
+                if (!events_handle) {
+                    // every event in the queue has the same type, so if the first one has no
+                    // managed counterpart, none of them do
+                    void* first_object = script_helpers::create_event_object(queue.get(0));
+                    if (first_object == nullptr) {
                         break;
                     }
 
-                    event_handle = object_ref::from_object(event_instance);
+                    void* event_class = script_helpers::get_core_type("SGE.Event", true);
+                    void* events = script_engine::create_array(event_class, queue.size());
+                    script_engine::set_array_element(events, 0, first_object);
+
+                    for (size_t i = 1; i < queue.size(); i++) {
+                        void* event_object = script_helpers::create_event_object(queue.get(i));
+                        script_engine::set_array_element(events, i, event_object);
+                    }
+
+                    events_handle = object_ref::from_object(events);
                 }
 
-                verify_script(current);
-                void* script_instance = sc.instance->get();
+                entity e(subscriber, this);
+                verify_script(e);
+
+                void* instance = sc.instance->get();
+                void* events = events_handle->get();
 
-                void* event_instance = event_handle->get();
-                script_engine::call_method(script_instance, OnEvent, event_instance);
+                if (callbacks.thunks.on_events != nullptr) {
+                    script_engine::call_thunk(callbacks.thunks.on_events, instance, events);
+                    continue;
+                }
+
+                // scripts that only handle single events are called once per event
+                for (size_t i = 0; i < queue.size(); i++) {
+                    void* event_object = script_engine::get_array_element(events, i);
+                    script_engine::call_thunk(callbacks.thunks.on_event, instance, event_object);
+                }
             }
-        }
+        });
+
+        m_event_queues.clear();
     }
 
     void scene::set_viewport_size(uint32_t width, uint32_t height) {
@@ -1040,8 +1949,36 @@ namespace sge {
     }
 
     void scene::for_each(const std::function<void(entity)>& callback) {
-        m_registry.each(
-            [callback, this](entt::entity id) mutable { view_iteration(id, callback); });
+        m_registry.each([callback, this](entt::entity id) mutable {
+            if (!m_registry.all_of<inactive_component>(id)) {
+                view_iteration(id, callback);
+            }
+        });
+    }
+
+    size_t scene::query(const std::vector<entt::sparse_set*>& storages, entt::entity* ids,
+                        size_t capacity) {
+        if (storages.empty()) {
+            return 0;
+        }
+
+        entt::runtime_view view;
+        for (auto storage : storages) {
+            view.iterate(*storage);
+        }
+
+        view.exclude(m_registry.storage<inactive_component>());
+
+        size_t count = 0;
+        for (entt::entity id : view) {
+            if (count < capacity) {
+                ids[count] = id;
+            }
+
+            count++;
+        }
+
+        return count;
     }
 
     void scene::view_iteration(entt::entity id, const std::function<void(entity)>& callback) {
@@ -1057,19 +1994,8 @@ namespace sge {
             const auto& transform = _entity.get_component<transform_component>();
             const auto& sprite = _entity.get_component<sprite_renderer_component>();
 
-            auto _shader = sprite._shader;
-            if (!_shader) {
-                _shader = default_shader;
-            }
-
-            renderer::set_shader(_shader);
-            if (sprite.texture) {
-                renderer::draw_rotated_quad(transform.translation, transform.rotation,
-                                            transform.scale, sprite.color, sprite.texture);
-            } else {
-                renderer::draw_rotated_quad(transform.translation, transform.rotation,
-                                            transform.scale, sprite.color);
-            }
+            renderer::draw_rotated_quad(transform.translation, transform.rotation,
+                                        transform.scale, sprite.color, sprite.material);
         }
 
         if (m_render_colliders) {
@@ -1156,6 +2082,7 @@ namespace sge {
             sc = &e.get_component<script_component>();
         }
 
+        unregister_batched_script(e);
         sc->remove_script();
     }
 
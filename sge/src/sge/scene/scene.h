@@ -18,10 +18,15 @@
 
 #include "sge/events/event.h"
 #include "sge/events/window_events.h"
+#include "sge/events/event_queue.h"
 #include "sge/scene/editor_camera.h"
 #include "sge/core/guid.h"
+#include "sge/core/string_pool.h"
+#include "sge/scene/system_scheduler.h"
 #include <entt/entt.hpp>
 
+class b2Body;
+
 namespace sge {
 
     class entity;
@@ -29,13 +34,20 @@ namespace sge {
     struct script_deserializer;
     class scene_contact_listener;
     struct scene_physics_data;
+    struct body_command;
+    struct script_runner_data;
+    class scene_snapshot;
+    class prefab;
+    class snapshot_writer;
+    class snapshot_reader;
+    struct inactive_component;
 
     // A Scene is a set of entities and components.
     class scene : public ref_counted {
     public:
         static constexpr size_t collision_category_count = sizeof(uint16_t) * 8;
 
-        scene() = default;
+        scene();
         ~scene();
         scene(const scene&) = delete;
         scene& operator=(const scene&) = delete;
@@ -52,9 +64,47 @@ namespace sge {
         void verify_script(entity e);
 
         void update_physics_data(entity e);
+        void mark_physics_dirty(entity e);
         void recalculate_render_order();
         bool& colliders_rendered() { return m_render_colliders; }
 
+        // steps the physics world on a separate thread while the scene is rendered
+        bool& physics_threaded() { return m_threaded_physics; }
+
+        // updates managed scripts through SGE.ScriptRunner, with one call into managed code per
+        // frame. scripts are then updated grouped by class, and enabling or disabling a script
+        // takes effect on the next frame
+        bool& scripts_batched() { return m_batched_scripts; }
+
+        // the runner has to be dropped before the script domain is unloaded
+        void reset_script_runner();
+
+        // systems run by on_runtime_update
+        system_scheduler& get_systems() { return m_systems; }
+
+        // Registers a native system, which is given a view of every active entity with the
+        // given components each frame. Components that are only read should be passed as const,
+        // so that systems reading them can run in parallel. Native systems run after scripts and
+        // before physics.
+        template <typename... T, typename Func>
+        void add_native_system(const std::string& name, Func&& callback,
+                               bool main_thread = false) {
+            system_access access;
+            (add_component_access<T>(access), ...);
+
+            if (main_thread) {
+                access.main_thread();
+            }
+
+            m_systems.add_system(
+                name, access,
+                [callback](scene& _scene, timestep ts) {
+                    auto view = _scene.m_registry.view<T...>(entt::exclude<inactive_component>);
+                    callback(view, ts);
+                },
+                "physics");
+        }
+
         bool apply_force(entity e, glm::vec2 force, glm::vec2 point, bool wake = true);
         bool apply_force(entity e, glm::vec2 force, bool wake = true);
         bool apply_linear_impulse(entity e, glm::vec2 impulse, glm::vec2 point, bool wake = true);
@@ -70,6 +120,23 @@ namespace sge {
         entity find_guid(guid id);
         ref<scene> copy();
 
+        // entities are indexed by tag, so tags should only be changed through set_tag
+        void set_tag(entity e, const std::string& tag);
+        entity find_tag(const std::string& tag);
+        std::vector<entity> find_all_tagged(const std::string& tag);
+
+        // reuses a released instance of the prefab if there is one, instead of instantiating it
+        entity instantiate_pooled(ref<prefab> _prefab);
+
+        // deactivates pooled entities so that they can be reused. other entities are destroyed
+        void release_entity(entity e);
+        bool is_entity_active(entity e);
+
+        // snapshots can be restored any number of times. if a base snapshot is passed, only the
+        // difference between the two is stored
+        ref<scene_snapshot> snapshot(ref<scene_snapshot> base = nullptr);
+        void restore(ref<scene_snapshot> snapshot);
+
         std::string& collision_category_name(size_t index) {
             return m_collision_category_names[index];
         }
@@ -80,6 +147,11 @@ namespace sge {
         void on_editor_update(timestep ts, const editor_camera& camera);
         void on_event(event& e);
 
+        // native scripts only receive events of the types they subscribe to. managed scripts
+        // declare theirs with EventSubscriptionAttribute
+        void subscribe_event(entity e, event_id id);
+        void unsubscribe_event(entity e, event_id id);
+
         void set_viewport_size(uint32_t width, uint32_t height);
 
         void for_each(const std::function<void(entity)>& callback);
@@ -92,7 +164,27 @@ namespace sge {
             }
         }
 
+        // storages are passed to query, for component types that are only known at runtime
+        template <typename T>
+        entt::sparse_set& get_storage() {
+            return m_registry.storage<T>();
+        }
+
+        // writes up to capacity ids of the active entities that have every given component, and
+        // returns how many there are in total
+        size_t query(const std::vector<entt::sparse_set*>& storages, entt::entity* ids,
+                     size_t capacity);
+
     private:
+        template <typename T>
+        static void add_component_access(system_access& access) {
+            if constexpr (std::is_const_v<T>) {
+                access.read<std::remove_const_t<T>>();
+            } else {
+                access.write<T>();
+            }
+        }
+
         template <typename T>
         void on_component_added(const entity& e, T& component) {
             // no behavior
@@ -106,16 +198,59 @@ namespace sge {
         void view_iteration(entt::entity id, const std::function<void(entity)>& callback);
         void render();
 
+        void update_native_scripts(timestep ts);
+        void update_managed_scripts(timestep ts);
+        void update_batched_scripts(timestep ts);
+        void unregister_batched_script(entity e);
+        void render_runtime();
+        void dispatch_events();
+
+        void sync_physics_data();
+        b2Body* get_body(entity e);
+        void on_physics_component_updated(entt::registry& registry, entt::entity id);
+
+        void destroy_bodies();
+        void write_body_states(snapshot_writer& writer);
+        void read_body_states(snapshot_reader& reader);
+
+        void wait_for_physics_step();
+        void step_physics(timestep ts);
+        void finish_physics_step();
+        bool apply_body_command(entity e, body_command& command);
+
+        void insert_into_render_order(entity e);
+
+        void on_tag_added(entt::registry& registry, entt::entity id);
+        void on_tag_removed(entt::registry& registry, entt::entity id);
+        const std::vector<entt::entity>* get_tagged(const std::string& tag);
+
         void remove_script(entity e, void* component = nullptr);
         guid get_guid(entity e);
 
+        struct entity_pool {
+            ref<prefab> source;
+            std::vector<entt::entity> available;
+        };
+
         entt::registry m_registry;
         std::vector<entity> m_render_order;
+        std::unordered_map<string_handle, std::vector<entt::entity>> m_tag_index;
+        std::unordered_map<entt::entity, size_t> m_tag_positions; // within m_tag_index
+        std::unordered_map<prefab*, entity_pool> m_entity_pools;
         uint32_t m_viewport_width, m_viewport_height;
 
         scene_physics_data* m_physics_data = nullptr;
         std::array<std::string, collision_category_count> m_collision_category_names;
         bool m_render_colliders = false;
+        bool m_threaded_physics = false;
+
+        bool m_batched_scripts = false;
+        script_runner_data* m_script_runner = nullptr;
+
+        system_scheduler m_systems;
+
+        event_queues m_event_queues;
+        event_subscriptions m_event_subscriptions;
 
         friend class entity;
         friend class box2d_contact_listener;
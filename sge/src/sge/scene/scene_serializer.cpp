@@ -29,7 +29,7 @@ namespace sge {
     void to_json(json& data, const id_component& comp) { data = comp.id; }
     void from_json(const json& data, id_component& comp) { comp.id = data.get<guid>(); }
 
-    void to_json(json& data, const tag_component& comp) { data = comp.tag; }
+    void to_json(json& data, const tag_component& comp) { data = comp.tag.str(); }
     void from_json(const json& data, tag_component& comp) { comp.tag = data.get<std::string>(); }
 
     void to_json(json& data, const transform_component& comp) {
@@ -133,14 +133,16 @@ namespace sge {
 
     void to_json(json& data, const sprite_renderer_component& comp) {
         data["color"] = comp.color;
-        data["texture"] = serialize_asset_path(comp.texture);
-        data["shader"] = serialize_asset_path(comp._shader);
+        const auto& material = material_table::get(comp.material);
+        data["texture"] = serialize_asset_path(material.texture);
+        data["shader"] = serialize_asset_path(material._shader);
     }
 
     void from_json(const json& data, sprite_renderer_component& comp) {
         comp.color = data["color"].get<glm::vec4>();
-        comp.texture = deserialize_asset_path<texture_2d>(data["texture"]);
-        comp._shader = deserialize_asset_path<shader>(data["shader"]);
+        auto texture = deserialize_asset_path<texture_2d>(data["texture"]);
+        auto _shader = deserialize_asset_path<shader>(data["shader"]);
+        comp.material = material_table::intern(_shader, texture);
     }
 
     void to_json(json& data, const rigid_body_component& rb) {
@@ -261,26 +263,22 @@ namespace sge {
             return;
         }
 
-        data["script_name"] = component.class_name;
+        data["script_name"] = component.class_name.str();
         data["enabled"] = component.enabled;
         data["properties"] = nullptr;
 
         if (component.instance && component.instance->get() != nullptr) {
             void* instance = component.instance->get();
 
-            std::vector<void*> properties;
-            script_engine::iterate_properties(component._class, properties);
-
+            const auto& properties = script_property_cache::get(component._class);
             if (!properties.empty()) {
                 json property_data;
-                for (void* property : properties) {
-                    if (!script_helpers::is_property_serializable(property)) {
+                for (const auto& property : properties) {
+                    if (!property.serializable) {
                         continue;
                     }
 
-                    std::string property_name = script_engine::get_property_name(property);
-                    json& result = property_data[property_name];
-
+                    json& result = property_data[property.name];
                     script_helpers::serialize_property(instance, property, result);
                 }
 
@@ -296,21 +294,18 @@ namespace sge {
             component.verify_script(current_entity);
             void* instance = component.instance->get();
 
-            std::vector<void*> properties;
-            script_engine::iterate_properties(component._class, properties);
-
-            for (void* property : properties) {
-                if (!script_helpers::is_property_serializable(property)) {
+            const auto& properties = script_property_cache::get(component._class);
+            for (const auto& property : properties) {
+                if (!property.serializable) {
                     continue;
                 }
 
-                std::string property_name = script_engine::get_property_name(property);
-                if (property_data.find(property_name) == property_data.end()) {
+                auto it = property_data.find(property.name);
+                if (it == property_data.end()) {
                     continue;
                 }
 
-                const json& data = property_data[property_name];
-                script_helpers::deserialize_property(instance, property, data);
+                script_helpers::deserialize_property(instance, property, *it);
             }
         }
     };
@@ -392,7 +387,11 @@ namespace sge {
             deserialize_component<id_component>(e, "guid", data);
         }
 
-        deserialize_component<tag_component>(e, "tag", data);
+        // tags are indexed by the scene
+        if (data.find("tag") != data.end() && !data["tag"].is_null()) {
+            e.get_scene()->set_tag(e, data["tag"].get<std::string>());
+        }
+
         deserialize_component<transform_component>(e, "transform", data);
         deserialize_component<camera_component>(e, "camera", data);
         deserialize_component<sprite_renderer_component>(e, "sprite", data);
@@ -0,0 +1,625 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/scene/scene_snapshot.h"
+#include "sge/scene/scene.h"
+#include "sge/scene/entity.h"
+#include "sge/scene/components.h"
+#include "sge/scene/prefab.h"
+#include "sge/script/script_engine.h"
+#include "sge/script/script_helpers.h"
+
+namespace sge {
+    // runs of equal bytes shorter than this are stored as part of the changed data
+    static constexpr size_t delta_min_match = 16;
+
+    // a full snapshot is stored instead of a delta once a chain of deltas gets this long, so that
+    // decoding stays cheap and old chains can be freed
+    static constexpr uint32_t max_delta_chain = 8;
+
+    static void encode_delta(const std::vector<uint8_t>& base, const std::vector<uint8_t>& data,
+                             std::vector<uint8_t>& result) {
+        auto matches = [&](size_t position) {
+            return position < base.size() && data[position] == base[position];
+        };
+
+        auto write_u32 = [&](uint32_t value) {
+            const uint8_t* bytes = (const uint8_t*)&value;
+            result.insert(result.end(), bytes, bytes + sizeof(uint32_t));
+        };
+
+        result.clear();
+        size_t position = 0;
+
+        while (position < data.size()) {
+            size_t match_start = position;
+            while (position < data.size() && matches(position)) {
+                position++;
+            }
+
+            size_t literal_start = position;
+            while (position < data.size()) {
+                size_t run = 0;
+                while (run < delta_min_match && position + run < data.size() &&
+                       matches(position + run)) {
+                    run++;
+                }
+
+                if (run == delta_min_match) {
+                    break;
+                }
+
+                position = std::min(position + run + 1, data.size());
+            }
+
+            write_u32((uint32_t)(literal_start - match_start));
+            write_u32((uint32_t)(position - literal_start));
+            result.insert(result.end(), data.begin() + literal_start, data.begin() + position);
+        }
+    }
+
+    void scene_snapshot::decode(std::vector<uint8_t>& data) const {
+        if (!m_base) {
+            data = m_data;
+            return;
+        }
+
+        m_base->decode(data);
+        data.resize(m_size);
+
+        size_t position = 0;
+        size_t offset = 0;
+        while (offset < m_data.size()) {
+            uint32_t matched, literal;
+            memcpy(&matched, &m_data[offset], sizeof(uint32_t));
+            memcpy(&literal, &m_data[offset + sizeof(uint32_t)], sizeof(uint32_t));
+            offset += sizeof(uint32_t) * 2;
+
+            // matched bytes are already in place
+            position += matched;
+
+            memcpy(&data[position], &m_data[offset], literal);
+            position += literal;
+            offset += literal;
+        }
+    }
+
+    void snapshot_writer::write(const void* data, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    void snapshot_writer::write_string(const std::string& value) {
+        write<uint64_t>(value.length());
+        write(value.data(), value.length());
+    }
+
+    void snapshot_writer::write_asset(ref<asset> _asset) {
+        if (!_asset) {
+            write<int32_t>(-1);
+            return;
+        }
+
+        auto it = m_asset_indices.find(_asset.raw());
+        if (it != m_asset_indices.end()) {
+            write(it->second);
+            return;
+        }
+
+        int32_t index = (int32_t)m_assets.size();
+        m_assets.push_back(_asset);
+        m_asset_indices.insert(std::make_pair(_asset.raw(), index));
+
+        write(index);
+    }
+
+    void snapshot_writer::write_object(void* object) {
+        if (object == nullptr) {
+            write<int32_t>(-1);
+            return;
+        }
+
+        void* copy = script_engine::clone_object(object);
+        write((int32_t)m_objects.size());
+        m_objects.push_back(object_ref::from_object(copy));
+    }
+
+    void snapshot_writer::write_prefab(ref<prefab> _prefab) {
+        if (!_prefab) {
+            write<int32_t>(-1);
+            return;
+        }
+
+        auto it = m_prefab_indices.find(_prefab.raw());
+        if (it != m_prefab_indices.end()) {
+            write(it->second);
+            return;
+        }
+
+        int32_t index = (int32_t)m_prefabs.size();
+        m_prefabs.push_back(_prefab);
+        m_prefab_indices.insert(std::make_pair(_prefab.raw(), index));
+
+        write(index);
+    }
+
+    ref<scene_snapshot> snapshot_writer::finish(ref<scene_snapshot> base) {
+        auto snapshot = ref<scene_snapshot>(new scene_snapshot);
+        snapshot->m_size = m_data.size();
+        snapshot->m_assets = std::move(m_assets);
+        snapshot->m_objects = std::move(m_objects);
+        snapshot->m_prefabs = std::move(m_prefabs);
+
+        if (base && base->m_chain_length < max_delta_chain) {
+            std::vector<uint8_t> base_data;
+            base->decode(base_data);
+
+            encode_delta(base_data, m_data, snapshot->m_data);
+            snapshot->m_base = base;
+            snapshot->m_chain_length = base->m_chain_length + 1;
+        } else {
+            snapshot->m_data = std::move(m_data);
+        }
+
+        m_data.clear();
+        m_asset_indices.clear();
+
+        return snapshot;
+    }
+
+    snapshot_reader::snapshot_reader(ref<scene_snapshot> snapshot) {
+        m_snapshot = snapshot;
+        m_snapshot->decode(m_data);
+        m_position = 0;
+    }
+
+    void snapshot_reader::read(void* data, size_t size) {
+        if (m_position + size > m_data.size()) {
+            throw std::runtime_error("attempted to read past the end of a snapshot!");
+        }
+
+        memcpy(data, &m_data[m_position], size);
+        m_position += size;
+    }
+
+    std::string snapshot_reader::read_string() {
+        std::string value;
+        value.resize((size_t)read<uint64_t>());
+        read(value.data(), value.length());
+
+        return value;
+    }
+
+    ref<asset> snapshot_reader::read_asset() {
+        int32_t index = read<int32_t>();
+        if (index < 0) {
+            return nullptr;
+        }
+
+        return m_snapshot->m_assets[index];
+    }
+
+    void* snapshot_reader::read_object() {
+        int32_t index = read<int32_t>();
+        if (index < 0) {
+            return nullptr;
+        }
+
+        // clone again so that the snapshot can be restored more than once. the handle is gone if
+        // assemblies were reloaded since the snapshot was taken
+        void* object = m_snapshot->m_objects[index]->get();
+        return object != nullptr ? script_engine::clone_object(object) : nullptr;
+    }
+
+    ref<prefab> snapshot_reader::read_prefab() {
+        int32_t index = read<int32_t>();
+        if (index < 0) {
+            return nullptr;
+        }
+
+        return m_snapshot->m_prefabs[index];
+    }
+
+    template <typename T>
+    static void write_storage(entt::registry& registry, snapshot_writer& writer) {
+        auto& storage = registry.storage<T>();
+        const entt::sparse_set& entities = storage;
+
+        writer.write<uint64_t>(storage.size());
+        for (entt::entity id : entities) {
+            writer.write(id);
+        }
+
+        for (const T& component : storage) {
+            writer.write(component);
+        }
+    }
+
+    template <typename T>
+    static void read_storage(entt::registry& registry, snapshot_reader& reader) {
+        size_t count = (size_t)reader.read<uint64_t>();
+
+        std::vector<entt::entity> entities(count);
+        for (size_t i = 0; i < count; i++) {
+            entities[i] = reader.read<entt::entity>();
+        }
+
+        std::vector<T> components;
+        components.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            components.push_back(reader.read<T>());
+        }
+
+        registry.insert<T>(entities.begin(), entities.end(), components.begin());
+    }
+
+    enum class snapshot_property_kind : uint8_t { null = 0, value, entity, asset, object };
+
+    // properties are written along with their names, so that they can be matched up with the
+    // properties of the class after assemblies have been reloaded
+    static void write_script_properties(snapshot_writer& writer, script_component& sc) {
+        void* instance = sc.instance ? sc.instance->get() : nullptr;
+        writer.write(instance != nullptr);
+        if (instance == nullptr) {
+            return;
+        }
+
+        void* entity_class = script_helpers::get_core_type("SGE.Entity", true);
+        void* asset_class = script_helpers::get_core_type("SGE.Asset", true);
+
+        const auto& properties = script_property_cache::get(sc._class);
+        uint64_t serializable_count = 0;
+        for (const auto& descriptor : properties) {
+            if (descriptor.serializable) {
+                serializable_count++;
+            }
+        }
+
+        writer.write(serializable_count);
+        for (const auto& descriptor : properties) {
+            if (!descriptor.serializable) {
+                continue;
+            }
+
+            writer.write_string(descriptor.name);
+
+            void* property_type = descriptor.type;
+            void* value = script_engine::get_property_value(instance, descriptor.property);
+
+            if (value == nullptr) {
+                writer.write(snapshot_property_kind::null);
+            } else if (descriptor.value_type) {
+                writer.write(snapshot_property_kind::value);
+
+                size_t size = script_helpers::get_type_size(property_type);
+                writer.write<uint64_t>(size);
+                writer.write(script_engine::unbox_object(value), size);
+            } else if (property_type == entity_class) {
+                writer.write(snapshot_property_kind::entity);
+
+                entity e = script_helpers::get_entity_from_object(value);
+                writer.write((entt::entity)e);
+            } else if (script_helpers::type_extends(property_type, asset_class)) {
+                writer.write(snapshot_property_kind::asset);
+                writer.write_asset(script_helpers::get_asset_from_object(value));
+            } else {
+                writer.write(snapshot_property_kind::object);
+                writer.write_object(value);
+            }
+        }
+    }
+
+    static void read_script_properties(snapshot_reader& reader, entity e, script_component& sc) {
+        if (!reader.read<bool>()) {
+            return;
+        }
+
+        // if the class no longer exists, the data is still read so that the rest of the
+        // snapshot lines up
+        void* instance = nullptr;
+        if (sc._class != nullptr) {
+            sc.verify_script(e);
+            instance = sc.instance->get();
+        }
+
+        std::vector<uint8_t> buffer;
+        size_t count = (size_t)reader.read<uint64_t>();
+
+        for (size_t i = 0; i < count; i++) {
+            std::string name = reader.read_string();
+
+            void* property = nullptr;
+            if (instance != nullptr) {
+                const auto* descriptor = script_property_cache::find(sc._class, name);
+                if (descriptor != nullptr && descriptor->serializable) {
+                    property = descriptor->property;
+                }
+            }
+
+            void* value = nullptr;
+            auto kind = reader.read<snapshot_property_kind>();
+            switch (kind) {
+            case snapshot_property_kind::null:
+                break;
+            case snapshot_property_kind::value:
+                buffer.resize((size_t)reader.read<uint64_t>());
+                reader.read(buffer.data(), buffer.size());
+
+                value = buffer.data();
+                break;
+            case snapshot_property_kind::entity: {
+                entity found(reader.read<entt::entity>(), e.get_scene());
+                if (property != nullptr) {
+                    value = script_helpers::create_entity_object(found);
+                }
+            } break;
+            case snapshot_property_kind::asset: {
+                auto _asset = reader.read_asset();
+                if (property != nullptr) {
+                    value = script_helpers::create_asset_object(_asset);
+                }
+            } break;
+            case snapshot_property_kind::object:
+                value = reader.read_object();
+                break;
+            default:
+                throw std::runtime_error("invalid property kind in snapshot!");
+            }
+
+            if (property != nullptr) {
+                script_engine::set_property_value(instance, property, value);
+            }
+        }
+    }
+
+    static void* find_script_class(const std::string& name) {
+        for (size_t i = 0; i < script_engine::get_assembly_count(); i++) {
+            void* assembly = script_engine::get_assembly(i);
+            if (assembly == nullptr) {
+                continue;
+            }
+
+            void* _class = script_engine::get_class(assembly, name);
+            if (_class != nullptr) {
+                return _class;
+            }
+        }
+
+        return nullptr;
+    }
+
+    ref<scene_snapshot> scene::snapshot(ref<scene_snapshot> base) {
+        wait_for_physics_step();
+        snapshot_writer writer;
+
+        for (const auto& name : m_collision_category_names) {
+            writer.write_string(name);
+        }
+
+        std::vector<entt::entity> entities;
+        m_registry.each([&](entt::entity id) { entities.push_back(id); });
+
+        writer.write<uint64_t>(entities.size());
+        writer.write(entities.data(), entities.size() * sizeof(entt::entity));
+
+        {
+            auto view = m_registry.view<id_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                writer.write(id);
+                writer.write((uint64_t)view.get<id_component>(id).id);
+            }
+        }
+
+        // plain data components are written storage-by-storage
+        write_storage<transform_component>(m_registry, writer);
+        write_storage<camera_component>(m_registry, writer);
+        write_storage<rigid_body_component>(m_registry, writer);
+        write_storage<box_collider_component>(m_registry, writer);
+        write_storage<circle_collider_component>(m_registry, writer);
+
+        {
+            auto view = m_registry.view<tag_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                writer.write(id);
+                writer.write_string(view.get<tag_component>(id).tag);
+            }
+        }
+
+        {
+            auto view = m_registry.view<sprite_renderer_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                const auto& sprite = view.get<sprite_renderer_component>(id);
+
+                writer.write(id);
+                writer.write(sprite.color);
+                const auto& material = material_table::get(sprite.material);
+                writer.write_asset(material.texture);
+                writer.write_asset(material._shader);
+            }
+        }
+
+        {
+            auto view = m_registry.view<shape_collider_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                const auto& sc = view.get<shape_collider_component>(id);
+
+                writer.write(id);
+                writer.write((const collider_data&)sc);
+                writer.write_asset(sc._shape);
+            }
+        }
+
+        // native script instances can't be copied; they are instantiated again after restoring
+        {
+            auto view = m_registry.view<native_script_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                const auto& nsc = view.get<native_script_component>(id);
+
+                writer.write(id);
+                writer.write(nsc.instantiate);
+                writer.write(nsc.destroy);
+            }
+        }
+
+        {
+            auto view = m_registry.view<script_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                auto& sc = view.get<script_component>(id);
+
+                // class pointers don't survive reloading assemblies, so classes are looked up
+                // by name when restoring
+                writer.write(id);
+                writer.write_string(sc.class_name);
+                writer.write(sc.enabled);
+
+                write_script_properties(writer, sc);
+            }
+        }
+
+        {
+            auto view = m_registry.view<pooled_component>();
+            writer.write<uint64_t>(view.size());
+
+            for (entt::entity id : view) {
+                const auto& pooled = view.get<pooled_component>(id);
+
+                writer.write(id);
+                writer.write_prefab(m_entity_pools[pooled.source].source);
+                writer.write(pooled.initial_transform);
+                writer.write(m_registry.all_of<inactive_component>(id));
+            }
+        }
+
+        write_body_states(writer);
+        return writer.finish(base);
+    }
+
+    void scene::restore(ref<scene_snapshot> snapshot) {
+        snapshot_reader reader(snapshot);
+        clear();
+
+        for (auto& name : m_collision_category_names) {
+            name = reader.read_string();
+        }
+
+        // recreate entities with their original identifiers, so that existing handles stay valid
+        size_t entity_count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < entity_count; i++) {
+            m_registry.create(reader.read<entt::entity>());
+        }
+
+        size_t count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            m_registry.emplace<id_component>(id, guid(reader.read<uint64_t>()));
+        }
+
+        read_storage<transform_component>(m_registry, reader);
+        read_storage<camera_component>(m_registry, reader);
+        read_storage<rigid_body_component>(m_registry, reader);
+        read_storage<box_collider_component>(m_registry, reader);
+        read_storage<circle_collider_component>(m_registry, reader);
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            m_registry.emplace<tag_component>(id, reader.read_string());
+        }
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            auto& sprite = m_registry.emplace<sprite_renderer_component>(id);
+
+            sprite.color = reader.read<glm::vec4>();
+            auto texture = reader.read_asset().as<texture_2d>();
+            auto _shader = reader.read_asset().as<shader>();
+            sprite.material = material_table::intern(_shader, texture);
+        }
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            auto& sc = m_registry.emplace<shape_collider_component>(id);
+
+            (collider_data&)sc = reader.read<collider_data>();
+            sc._shape = reader.read_asset().as<shape>();
+        }
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            auto& nsc = m_registry.emplace<native_script_component>(id);
+
+            nsc.instantiate = reader.read<decltype(nsc.instantiate)>();
+            nsc.destroy = reader.read<decltype(nsc.destroy)>();
+        }
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            entity e(reader.read<entt::entity>(), this);
+            auto& sc = m_registry.emplace<script_component>(e);
+
+            sc.class_name = reader.read_string();
+            sc.enabled = reader.read<bool>();
+
+            sc._class = find_script_class(sc.class_name);
+            if (sc._class == nullptr) {
+                spdlog::warn("script class {0} no longer exists - dropping its snapshot data",
+                             sc.class_name.str());
+            }
+
+            read_script_properties(reader, e, sc);
+        }
+
+        count = (size_t)reader.read<uint64_t>();
+        for (size_t i = 0; i < count; i++) {
+            auto id = reader.read<entt::entity>();
+            auto source = reader.read_prefab();
+
+            auto& pooled = m_registry.emplace<pooled_component>(id);
+            pooled.source = source.raw();
+            pooled.initial_transform = reader.read<transform_component>();
+
+            auto& pool = m_entity_pools[source.raw()];
+            pool.source = source;
+
+            if (reader.read<bool>()) {
+                m_registry.emplace<inactive_component>(id);
+                pool.available.push_back(id);
+            }
+        }
+
+        // components were added without invoking the component hooks
+        set_viewport_size(m_viewport_width, m_viewport_height);
+        recalculate_render_order();
+
+        read_body_states(reader);
+    }
+} // namespace sge
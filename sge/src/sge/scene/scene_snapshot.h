@@ -0,0 +1,126 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/asset/asset.h"
+#include "sge/scene/prefab.h"
+#include "sge/script/garbage_collector.h"
+
+namespace sge {
+    class scene_snapshot;
+
+    class snapshot_writer {
+    public:
+        snapshot_writer() = default;
+        ~snapshot_writer() = default;
+
+        snapshot_writer(const snapshot_writer&) = delete;
+        snapshot_writer& operator=(const snapshot_writer&) = delete;
+
+        void write(const void* data, size_t size);
+
+        template <typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "value cannot be copied bytewise!");
+            write(&value, sizeof(T));
+        }
+
+        void write_string(const std::string& value);
+        void write_asset(ref<asset> _asset);
+
+        // managed objects are cloned, so that the snapshot does not change along with the scene
+        void write_object(void* object);
+
+        // prefabs are held by the snapshot, as ones created at runtime can't be loaded again
+        void write_prefab(ref<prefab> _prefab);
+
+        ref<scene_snapshot> finish(ref<scene_snapshot> base);
+
+    private:
+        std::vector<uint8_t> m_data;
+        std::vector<ref<asset>> m_assets;
+        std::unordered_map<asset*, int32_t> m_asset_indices;
+        std::vector<ref<object_ref>> m_objects;
+        std::vector<ref<prefab>> m_prefabs;
+        std::unordered_map<prefab*, int32_t> m_prefab_indices;
+    };
+
+    class snapshot_reader {
+    public:
+        snapshot_reader(ref<scene_snapshot> snapshot);
+        ~snapshot_reader() = default;
+
+        snapshot_reader(const snapshot_reader&) = delete;
+        snapshot_reader& operator=(const snapshot_reader&) = delete;
+
+        void read(void* data, size_t size);
+
+        template <typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>, "value cannot be copied bytewise!");
+
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        std::string read_string();
+        ref<asset> read_asset();
+        void* read_object();
+        ref<prefab> read_prefab();
+
+    private:
+        ref<scene_snapshot> m_snapshot;
+        std::vector<uint8_t> m_data;
+        size_t m_position;
+    };
+
+    // A binary copy of the state of a scene, created with scene::snapshot. If a base snapshot is
+    // given, only the difference from it is stored, unless the base is already at the end of a
+    // long chain of differences.
+    class scene_snapshot : public ref_counted {
+    public:
+        scene_snapshot(const scene_snapshot&) = delete;
+        scene_snapshot& operator=(const scene_snapshot&) = delete;
+
+        ref<scene_snapshot> get_base() const { return m_base; }
+
+        // size of the uncompressed state
+        size_t get_size() const { return m_size; }
+
+        // size of the data this snapshot actually holds
+        size_t get_stored_size() const { return m_data.size(); }
+
+        void decode(std::vector<uint8_t>& data) const;
+
+    private:
+        scene_snapshot() = default;
+
+        std::vector<uint8_t> m_data;
+        size_t m_size = 0;
+        ref<scene_snapshot> m_base;
+
+        // number of deltas between this snapshot and the full one it is based on
+        uint32_t m_chain_length = 0;
+
+        std::vector<ref<asset>> m_assets;
+        std::vector<ref<object_ref>> m_objects;
+        std::vector<ref<prefab>> m_prefabs;
+
+        friend class snapshot_writer;
+        friend class snapshot_reader;
+    };
+} // namespace sge
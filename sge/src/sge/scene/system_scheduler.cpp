@@ -0,0 +1,168 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/scene/system_scheduler.h"
+#include "sge/core/job_system.h"
+
+namespace sge {
+    static bool contains_any(const std::vector<entt::id_type>& lhs,
+                             const std::vector<entt::id_type>& rhs) {
+        for (auto type : lhs) {
+            if (std::find(rhs.begin(), rhs.end(), type) != rhs.end()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool system_access::conflicts_with(const system_access& other) const {
+        if (m_exclusive || other.m_exclusive) {
+            return true;
+        }
+
+        return contains_any(m_writes, other.m_reads) || contains_any(m_writes, other.m_writes) ||
+               contains_any(other.m_writes, m_reads);
+    }
+
+    void system_scheduler::add_system(const std::string& name, const system_access& access,
+                                      const system_callback& callback, const std::string& before) {
+        if (has_system(name)) {
+            throw std::runtime_error("a system named " + name + " already exists!");
+        }
+
+        auto it = std::find_if(m_systems.begin(), m_systems.end(),
+                               [&](const system_t& system) { return system.name == before; });
+
+        if (!before.empty() && it == m_systems.end()) {
+            throw std::runtime_error("no system named " + before + " exists!");
+        }
+
+        auto& system = *m_systems.insert(it, system_t());
+        system.name = name;
+        system.access = access;
+        system.callback = callback;
+
+        m_stages_dirty = true;
+    }
+
+    bool system_scheduler::remove_system(const std::string& name) {
+        auto it = std::find_if(m_systems.begin(), m_systems.end(),
+                               [&](const system_t& system) { return system.name == name; });
+
+        if (it == m_systems.end()) {
+            return false;
+        }
+
+        m_systems.erase(it);
+        m_stages_dirty = true;
+        return true;
+    }
+
+    bool system_scheduler::has_system(const std::string& name) const {
+        for (const auto& system : m_systems) {
+            if (system.name == name) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void system_scheduler::copy_systems(const system_scheduler& other) {
+        m_systems = other.m_systems;
+        m_stages_dirty = true;
+    }
+
+    const std::vector<std::vector<size_t>>& system_scheduler::get_stages() {
+        if (m_stages_dirty) {
+            build_stages();
+        }
+
+        return m_stages;
+    }
+
+    void system_scheduler::build_stages() {
+        m_stages.clear();
+
+        // a system runs in the stage after the last earlier system it conflicts with
+        std::vector<size_t> system_stages(m_systems.size());
+        for (size_t i = 0; i < m_systems.size(); i++) {
+            size_t stage = 0;
+            for (size_t j = 0; j < i; j++) {
+                if (m_systems[i].access.conflicts_with(m_systems[j].access)) {
+                    stage = std::max(stage, system_stages[j] + 1);
+                }
+            }
+
+            system_stages[i] = stage;
+            if (stage >= m_stages.size()) {
+                m_stages.resize(stage + 1);
+            }
+
+            m_stages[stage].push_back(i);
+        }
+
+        m_stages_dirty = false;
+    }
+
+    void system_scheduler::run(scene& _scene, entt::registry& registry, timestep ts) {
+        const auto& stages = get_stages();
+        for (const auto& stage : stages) {
+            std::vector<const system_t*> main_thread_systems, worker_systems;
+            for (size_t index : stage) {
+                const auto& system = m_systems[index];
+                for (const auto& assure : system.access.m_assure) {
+                    assure(registry);
+                }
+
+                if (system.access.m_main_thread || stage.size() == 1) {
+                    main_thread_systems.push_back(&system);
+                } else {
+                    worker_systems.push_back(&system);
+                }
+            }
+
+            job_counter counter;
+            for (auto system : worker_systems) {
+                job_system::submit([&, system]() { system->callback(_scene, ts); }, &counter);
+            }
+
+            // jobs reference this stack frame, so they have to finish before anything is thrown
+            std::exception_ptr exception;
+            try {
+                for (auto system : main_thread_systems) {
+                    system->callback(_scene, ts);
+                }
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            try {
+                job_system::wait(counter);
+            } catch (...) {
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+} // namespace sge
@@ -0,0 +1,113 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include <entt/entt.hpp>
+
+namespace sge {
+    class scene;
+
+    // Describes which component types a system touches. Systems that don't conflict with each
+    // other are run in parallel.
+    class system_access {
+    public:
+        template <typename... T>
+        system_access& read() {
+            (add_type<T>(m_reads), ...);
+            return *this;
+        }
+
+        template <typename... T>
+        system_access& write() {
+            (add_type<T>(m_writes), ...);
+            return *this;
+        }
+
+        // exclusive systems conflict with every other system. this is meant for systems that can
+        // touch any component, or that create and destroy entities
+        system_access& exclusive() {
+            m_exclusive = true;
+            return *this;
+        }
+
+        // runs the system on the thread that updates the scene, e.g. for rendering or scripting
+        system_access& main_thread() {
+            m_main_thread = true;
+            return *this;
+        }
+
+        bool conflicts_with(const system_access& other) const;
+
+    private:
+        template <typename T>
+        void add_type(std::vector<entt::id_type>& types) {
+            types.push_back(entt::type_id<T>().hash());
+            m_assure.push_back([](entt::registry& registry) { registry.storage<T>(); });
+        }
+
+        std::vector<entt::id_type> m_reads, m_writes;
+        bool m_exclusive = false;
+        bool m_main_thread = false;
+
+        // storages are created before systems run concurrently, as creating one modifies the
+        // registry
+        std::vector<std::function<void(entt::registry&)>> m_assure;
+
+        friend class system_scheduler;
+    };
+
+    // Runs the systems of a scene each frame. Systems run in the order they were added, except that
+    // systems that don't conflict with an earlier one may run alongside it on the job system.
+    // Systems that aren't run on the main thread must not create or destroy entities.
+    class system_scheduler {
+    public:
+        using system_callback = std::function<void(scene&, timestep)>;
+
+        system_scheduler() = default;
+        ~system_scheduler() = default;
+
+        system_scheduler(const system_scheduler&) = delete;
+        system_scheduler& operator=(const system_scheduler&) = delete;
+
+        // if another system is named, the new system is placed in front of it
+        void add_system(const std::string& name, const system_access& access,
+                        const system_callback& callback, const std::string& before = std::string());
+
+        bool remove_system(const std::string& name);
+        bool has_system(const std::string& name) const;
+
+        // copies the systems of another scheduler
+        void copy_systems(const system_scheduler& other);
+
+        void run(scene& _scene, entt::registry& registry, timestep ts);
+
+        // sets of system indices that are run together, in order
+        const std::vector<std::vector<size_t>>& get_stages();
+
+    private:
+        struct system_t {
+            std::string name;
+            system_access access;
+            system_callback callback;
+        };
+
+        void build_stages();
+
+        std::vector<system_t> m_systems;
+        std::vector<std::vector<size_t>> m_stages;
+        bool m_stages_dirty = true;
+    };
+} // namespace sge
@@ -19,19 +19,114 @@
 #include "sge/script/mono_include.h"
 #include <mono/metadata/mono-gc.h>
 namespace sge {
-    struct gc_data_t {
-        std::unordered_set<object_ref*> refs;
+    // GC handles are kept in slots that are reused once freed. a slot's generation is bumped
+    // whenever it's freed, so that refs to freed handles can be told apart from the handles that
+    // replaced them
+    struct gc_handle_slot {
+        uint32_t handle = 0;
+        uint32_t generation = 0;
+        bool weak = false;
+
+        // null if the slot is free
+        object_ref* owner = nullptr;
+        uint32_t next_free;
     };
 
-    static std::unique_ptr<gc_data_t> gc_data;
+    static constexpr uint32_t invalid_slot = std::numeric_limits<uint32_t>::max();
+
+    // only touched from the thread running scripts. like gc_schedule, this isn't reset on
+    // shutdown, so that generations keep counting up
+    static struct {
+        std::vector<gc_handle_slot> slots;
+        uint32_t free_head = invalid_slot;
+        size_t live_count = 0;
+
+        bool initialized = false;
+    } gc_data;
+
+    // survives shutting down, so that the policy is kept when assemblies are reloaded
+    static struct {
+        gc_policy policy;
+        gc_frame_stats current_frame, last_frame;
+
+        // used heap size after the last collection
+        int64_t baseline = 0;
+
+        bool idle = false;
+        bool full_requested = false;
+        uint32_t deferred_frames = 0;
+    } gc_schedule;
+
+    static uint32_t allocate_slot() {
+        uint32_t index = gc_data.free_head;
+        if (index != invalid_slot) {
+            gc_data.free_head = gc_data.slots[index].next_free;
+        } else {
+            index = (uint32_t)gc_data.slots.size();
+            gc_data.slots.emplace_back();
+        }
+
+        gc_data.live_count++;
+        return index;
+    }
+
+    static void free_slot(uint32_t index) {
+        auto& slot = gc_data.slots[index];
+        slot.handle = 0;
+        slot.owner = nullptr;
+        slot.generation++;
+
+        slot.next_free = gc_data.free_head;
+        gc_data.free_head = index;
+        gc_data.live_count--;
+    }
+
+    // object_refs are created and released constantly (e.g. for every event), so they're carved
+    // out of slabs. slabs are never handed back, as refs can outlive static destruction
+    static constexpr size_t object_refs_per_slab = 256;
+    static void* free_object_refs = nullptr;
+
+    void* object_ref::operator new(size_t size) {
+        if (size != sizeof(object_ref)) {
+            return ::operator new(size);
+        }
+
+        if (free_object_refs == nullptr) {
+            static_assert(sizeof(object_ref) >= sizeof(void*));
+
+            auto slab = (uint8_t*)::operator new(sizeof(object_ref) * object_refs_per_slab);
+            for (size_t i = 0; i < object_refs_per_slab; i++) {
+                void* current = slab + i * sizeof(object_ref);
+                *(void**)current = free_object_refs;
+                free_object_refs = current;
+            }
+        }
+
+        void* result = free_object_refs;
+        free_object_refs = *(void**)result;
+        return result;
+    }
+
+    void object_ref::operator delete(void* ptr, size_t size) {
+        if (size != sizeof(object_ref)) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        *(void**)ptr = free_object_refs;
+        free_object_refs = ptr;
+    }
+
     bool object_ref::get_all(std::vector<ref<object_ref>>& refs) {
         refs.clear();
-        if (!gc_data) {
+        if (!gc_data.initialized) {
             return false;
         }
 
-        for (auto ptr : gc_data->refs) {
-            refs.push_back(ptr);
+        for (const auto& slot : gc_data.slots) {
+            if (slot.owner != nullptr) {
+                refs.push_back(slot.owner);
+            }
         }
 
         return true;
@@ -44,54 +139,58 @@ namespace sge {
     }
 
     void object_ref::set(void* object, bool weak) {
-        if (m_handle != 0) {
+        if (is_valid()) {
             destroy();
         }
 
         auto mono_object = (MonoObject*)object;
+
+        uint32_t handle;
         if (weak) {
-            m_handle = mono_gchandle_new_weakref(mono_object, false);
+            handle = mono_gchandle_new_weakref(mono_object, false);
         } else {
-            m_handle = mono_gchandle_new(mono_object, false);
+            handle = mono_gchandle_new(mono_object, false);
         }
 
-        if (m_handle == 0) {
+        if (handle == 0) {
             throw std::runtime_error("could not create a garbage collector ref!");
         }
 
-        m_weak = weak;
-        gc_data->refs.insert(this);
+        m_slot = allocate_slot();
+        auto& slot = gc_data.slots[m_slot];
+        slot.handle = handle;
+        slot.weak = weak;
+        slot.owner = this;
+
+        m_generation = slot.generation;
     }
 
     bool object_ref::destroy() {
-        if (m_handle == 0) {
+        if (!is_valid()) {
             return false;
         }
 
-        bool destroyed = true;
-        if (!m_weak) {
-            mono_gchandle_free(m_handle);
-        } else if (get() == nullptr) {
-            destroyed = false;
-        }
+        const auto& slot = gc_data.slots[m_slot];
+
+        // weak handles whose target has been collected still have to be freed
+        bool destroyed = !slot.weak || mono_gchandle_get_target(slot.handle) != nullptr;
+        mono_gchandle_free(slot.handle);
 
-        gc_data->refs.erase(this);
+        free_slot(m_slot);
         reset();
 
         return destroyed;
     }
 
     void* object_ref::get() {
-        if (m_handle == 0) {
+        if (!is_valid()) {
             return nullptr;
         }
 
-        MonoObject* object = mono_gchandle_get_target(m_handle);
-        if (object != nullptr && mono_object_get_vtable(object) == nullptr) {
-            return nullptr;
-        }
+        const auto& slot = gc_data.slots[m_slot];
+        MonoObject* object = mono_gchandle_get_target(slot.handle);
 
-        if (m_weak && object == nullptr) {
+        if (slot.weak && object == nullptr) {
             destroy();
         }
 
@@ -99,43 +198,127 @@ namespace sge {
     }
 
     void object_ref::reset() {
-        m_handle = 0;
-        m_weak = false;
+        m_slot = invalid_slot;
+        m_generation = 0;
+    }
+
+    bool object_ref::is_valid() const {
+        // refs outlive the handles freed when the garbage collector shuts down
+        return m_slot != invalid_slot && m_slot < gc_data.slots.size() &&
+               gc_data.slots[m_slot].generation == m_generation;
     }
 
     void garbage_collector::init() {
-        if (gc_data) {
+        if (gc_data.initialized) {
             throw std::runtime_error("the garbage collector has already been initialized!");
         }
 
-        gc_data = std::make_unique<gc_data_t>();
+        gc_data.initialized = true;
+
+        gc_schedule.current_frame.reset();
+        gc_schedule.last_frame.reset();
+        gc_schedule.baseline = mono_gc_get_used_size();
     }
 
     void garbage_collector::shutdown() {
-        if (!gc_data) {
+        if (!gc_data.initialized) {
             throw std::runtime_error("the garbage collector has not been initialized!");
         }
 
-        if (!gc_data->refs.empty()) {
+        if (gc_data.live_count > 0) {
             spdlog::warn("a memory leak has been detected!");
         }
 
-        std::unordered_set<object_ref*> refs(gc_data->refs.begin(), gc_data->refs.end());
-        for (auto object : refs) {
-            object->destroy();
+        for (const auto& slot : gc_data.slots) {
+            if (slot.owner != nullptr) {
+                slot.owner->destroy();
+            }
         }
 
         collect(true);
-        gc_data.reset();
+        gc_data.initialized = false;
+    }
+
+    static void collect_generation(int32_t generation) {
+        using namespace std::chrono;
+        auto t0 = steady_clock::now();
+
+        mono_gc_collect(generation);
+
+        auto t1 = steady_clock::now();
+        auto& stats = gc_schedule.current_frame;
+        stats.collection_time += duration_cast<duration<double, std::milli>>(t1 - t0).count();
+
+        if (generation == 0) {
+            stats.nursery_collections++;
+        } else {
+            stats.full_collections++;
+
+            gc_schedule.full_requested = false;
+            gc_schedule.deferred_frames = 0;
+        }
+
+        gc_schedule.baseline = mono_gc_get_used_size();
     }
 
     void garbage_collector::collect(bool wait) {
-        mono_gc_collect(mono_gc_max_generation());
+        collect_generation(mono_gc_max_generation());
 
         if (wait) {
-            while (mono_gc_pending_finalizers()) {
-                // nothing
+            wait_for_finalizers();
+        }
+    }
+
+    void garbage_collector::request_full_collection() { gc_schedule.full_requested = true; }
+    void garbage_collector::mark_idle_frame() { gc_schedule.idle = true; }
+
+    void garbage_collector::end_frame(bool idle) {
+        if (!gc_data.initialized) {
+            return;
+        }
+
+        idle |= gc_schedule.idle;
+        gc_schedule.idle = false;
+
+        const auto& policy = gc_schedule.policy;
+        if (gc_schedule.full_requested) {
+            gc_schedule.deferred_frames++;
+
+            if (idle || gc_schedule.deferred_frames > policy.max_deferred_frames) {
+                collect_generation(mono_gc_max_generation());
+            }
+        }
+
+        // mono collects on its own as well, which can leave the heap below the baseline
+        int64_t used_size = mono_gc_get_used_size();
+        gc_schedule.baseline = std::min(gc_schedule.baseline, used_size);
+
+        if (policy.nursery_budget > 0 &&
+            used_size - gc_schedule.baseline >= policy.nursery_budget) {
+            collect_generation(0);
+            used_size = gc_schedule.baseline;
+        }
+
+        auto& stats = gc_schedule.current_frame;
+        stats.heap_size = mono_gc_get_heap_size();
+        stats.used_size = used_size;
+
+        gc_schedule.last_frame = stats;
+        stats.reset();
+    }
+
+    void garbage_collector::wait_for_finalizers() {
+        // finalizers run on their own thread, so give it the core and back off to sleeping
+        for (uint32_t i = 0; mono_gc_pending_finalizers(); i++) {
+            if (i < 16) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
         }
     }
+
+    gc_policy& garbage_collector::get_policy() { return gc_schedule.policy; }
+
+    const gc_frame_stats& garbage_collector::get_frame_stats() { return gc_schedule.last_frame; }
 } // namespace sge
\ No newline at end of file
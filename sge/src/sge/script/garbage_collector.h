@@ -16,6 +16,8 @@
 
 #pragma once
 namespace sge {
+    // A handle to a managed object, which keeps it alive unless the handle is weak. Refs whose
+    // handles were freed by the garbage collector shutting down read as null.
     class object_ref : public ref_counted {
     public:
         static bool get_all(std::vector<ref<object_ref>>& refs);
@@ -32,11 +34,16 @@ namespace sge {
 
         void* get();
 
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
     private:
         void reset();
+        bool is_valid() const;
 
-        uint32_t m_handle;
-        bool m_weak;
+        // index and generation of the slot in the handle table
+        uint32_t m_slot;
+        uint32_t m_generation;
     };
 
     struct scope_ref {
@@ -57,12 +64,62 @@ namespace sge {
         ref<object_ref> m_ref;
     };
 
+    struct gc_policy {
+        // a nursery collection is run at the end of a frame once the managed heap has grown by
+        // this many bytes since the last collection. 0 disables them
+        int64_t nursery_budget = 8 * 1024 * 1024;
+
+        // a requested full collection is run anyway after this many frames without an idle one
+        uint32_t max_deferred_frames = 600;
+    };
+
+    struct gc_frame_stats {
+        // in milliseconds
+        double collection_time;
+
+        uint32_t nursery_collections;
+        uint32_t full_collections;
+
+        // in bytes, at the end of the frame
+        int64_t heap_size;
+        int64_t used_size;
+
+        void reset() {
+            collection_time = 0.0;
+
+            nursery_collections = 0;
+            full_collections = 0;
+
+            heap_size = 0;
+            used_size = 0;
+        }
+    };
+
     class garbage_collector {
     public:
         garbage_collector() = delete;
 
         static void init();
         static void shutdown();
+
+        // runs a full collection right away, e.g. while loading
         static void collect(bool wait = false);
+
+        // runs a full collection at the end of the next idle frame
+        static void request_full_collection();
+
+        // nothing time-critical happens in the current frame
+        static void mark_idle_frame();
+
+        // called by the application between frames. minimized windows count as idle
+        static void end_frame(bool idle = false);
+
+        // blocks until the finalizer thread has caught up, without spinning
+        static void wait_for_finalizers();
+
+        static gc_policy& get_policy();
+
+        // stats of the last completed frame
+        static const gc_frame_stats& get_frame_stats();
     };
 } // namespace sge
\ No newline at end of file
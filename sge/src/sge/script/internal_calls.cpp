@@ -32,12 +32,30 @@ namespace sge {
     struct component_callbacks_t {
         std::function<void*(entity)> add, get;
         std::function<bool(entity)> has;
+        std::function<entt::sparse_set&(scene*)> storage;
     };
 
     static struct {
-        std::unordered_map<void*, component_callbacks_t> component_callbacks;
+        // indexed by the ids passed from ComponentId<T>.Value
+        std::vector<component_callbacks_t> component_callbacks;
+        std::unordered_map<void*, int32_t> component_type_ids;
+
+        // reused by every query
+        std::vector<entt::sparse_set*> query_storages;
     } internal_script_call_data;
 
+    // layouts mirrored by the structs in SGE.Scriptcore/Components/ComponentData.cs
+    static_assert(offsetof(transform_component, z_layer) == 8);
+    static_assert(offsetof(transform_component, rotation) == 12);
+    static_assert(offsetof(transform_component, scale) == 16);
+    static_assert(offsetof(rigid_body_component, fixed_rotation) == 4);
+    static_assert(offsetof(rigid_body_component, filter_category) == 6);
+    static_assert(offsetof(rigid_body_component, filter_mask) == 8);
+    static_assert(offsetof(collider_data, sensor) == 16);
+    static_assert(sizeof(box_collider_component) == 28);
+    static_assert(sizeof(circle_collider_component) == 24);
+    static_assert(offsetof(camera_component, primary) == sizeof(runtime_camera));
+
     template <typename T>
     static void register_component_type(const std::string& managed_name) {
         class_name_t name;
@@ -47,15 +65,25 @@ namespace sge {
         void* scriptcore = script_engine::get_assembly(0);
         void* _class = script_engine::get_class(scriptcore, name);
 
-        component_callbacks_t callbacks;
+        auto& types = internal_script_call_data.component_callbacks;
+        int32_t id = (int32_t)types.size();
+
+        auto& callbacks = types.emplace_back();
         callbacks.add = [](entity e) { return &e.add_component<T>(); };
         callbacks.has = [](entity e) { return e.has_all<T>(); };
         callbacks.get = [](entity e) { return &e.get_component<T>(); };
+        callbacks.storage = [](scene* _scene) -> entt::sparse_set& {
+            return _scene->get_storage<T>();
+        };
 
-        internal_script_call_data.component_callbacks.insert(std::make_pair(_class, callbacks));
+        internal_script_call_data.component_type_ids.insert(std::make_pair(_class, id));
     }
 
     void script_engine::register_component_types() {
+        // class pointers don't survive reloading assemblies
+        internal_script_call_data.component_callbacks.clear();
+        internal_script_call_data.component_type_ids.clear();
+
         register_component_type<tag_component>("TagComponent");
         register_component_type<transform_component>("TransformComponent");
         register_component_type<sprite_renderer_component>("SpriteRendererComponent");
@@ -67,22 +95,13 @@ namespace sge {
         register_component_type<script_component>("ScriptComponent");
     }
 
-    static void verify_component_type_validity(void* reflection_type) {
-        void* _class = script_engine::from_reflection_type(reflection_type);
-        if (internal_script_call_data.component_callbacks.find(_class) ==
-            internal_script_call_data.component_callbacks.end()) {
-
-            class_name_t name_data;
-            script_engine::get_class_name(_class, name_data);
-
-            throw std::runtime_error("managed type " + script_engine::get_string(name_data) +
-                                     " is not registered as a component type!");
+    static const component_callbacks_t& get_component_callbacks(int32_t id) {
+        const auto& types = internal_script_call_data.component_callbacks;
+        if (id < 0 || (size_t)id >= types.size()) {
+            throw std::runtime_error("invalid component type id: " + std::to_string(id) + "!");
         }
-    }
 
-    static const component_callbacks_t& get_component_callbacks(void* component_type) {
-        void* _class = script_engine::from_reflection_type(component_type);
-        return internal_script_call_data.component_callbacks[_class];
+        return types[(size_t)id];
     }
 
     namespace internal_script_calls {
@@ -198,6 +217,18 @@ namespace sge {
             _scene->destroy_entity(e);
         }
 
+        static void ReleaseEntity(uint32_t entityID, scene* _scene) {
+            entity e((entt::entity)entityID, _scene);
+            if (e) {
+                _scene->release_entity(e);
+            }
+        }
+
+        static bool IsEntityActive(uint32_t entityID, scene* _scene) {
+            entity e((entt::entity)entityID, _scene);
+            return e && _scene->is_entity_active(e);
+        }
+
         static bool FindEntity(guid id, uint32_t* entityID, scene* _scene) {
             entity found_entity = _scene->find_guid(id);
             if (found_entity) {
@@ -208,6 +239,16 @@ namespace sge {
             return false;
         }
 
+        static bool FindEntityByTag(void* tag, uint32_t* entityID, scene* _scene) {
+            entity found_entity = _scene->find_tag(script_engine::from_managed_string(tag));
+            if (found_entity) {
+                *entityID = (uint32_t)found_entity;
+                return true;
+            }
+
+            return false;
+        }
+
         static void ForEach(void* callback, scene* _scene) {
             auto gc_ref = object_ref::from_object(callback);
             _scene->for_each([gc_ref](entity e) {
@@ -223,31 +264,55 @@ namespace sge {
             return script_engine::to_managed_string(name);
         }
 
+        static int32_t QueryEntities(scene* _scene, const int32_t* typeIDs, int32_t typeCount,
+                                     uint32_t* buffer, int32_t capacity) {
+            auto& storages = internal_script_call_data.query_storages;
+            storages.clear();
+
+            for (int32_t i = 0; i < typeCount; i++) {
+                const auto& callbacks = get_component_callbacks(typeIDs[i]);
+                storages.push_back(&callbacks.storage(_scene));
+            }
+
+            size_t count = _scene->query(storages, (entt::entity*)buffer,
+                                         (size_t)std::max(capacity, 0));
+
+            return (int32_t)count;
+        }
+
 #pragma endregion
 #pragma region Entity
 
-        static void* AddComponent(void* componentType, void* _entity) {
-            verify_component_type_validity(componentType);
-            entity e = script_helpers::get_entity_from_object(_entity);
+        static int32_t GetComponentTypeID(void* componentType) {
+            void* _class = script_engine::from_reflection_type(componentType);
 
-            const auto& callbacks = get_component_callbacks(componentType);
-            return callbacks.add(e);
-        }
+            const auto& ids = internal_script_call_data.component_type_ids;
+            auto it = ids.find(_class);
 
-        static bool HasComponent(void* componentType, void* _entity) {
-            verify_component_type_validity(componentType);
-            entity e = script_helpers::get_entity_from_object(_entity);
+            if (it == ids.end()) {
+                class_name_t name_data;
+                script_engine::get_class_name(_class, name_data);
 
-            const auto& callbacks = get_component_callbacks(componentType);
-            return callbacks.has(e);
+                throw std::runtime_error("managed type " + script_engine::get_string(name_data) +
+                                         " is not registered as a component type!");
+            }
+
+            return it->second;
         }
 
-        static void* GetComponent(void* componentType, void* _entity) {
-            verify_component_type_validity(componentType);
-            entity e = script_helpers::get_entity_from_object(_entity);
+        static void* AddComponent(int32_t typeID, uint32_t entityID, scene* _scene) {
+            entity e((entt::entity)entityID, _scene);
+            return get_component_callbacks(typeID).add(e);
+        }
+
+        static bool HasComponent(int32_t typeID, uint32_t entityID, scene* _scene) {
+            entity e((entt::entity)entityID, _scene);
+            return get_component_callbacks(typeID).has(e);
+        }
 
-            const auto& callbacks = get_component_callbacks(componentType);
-            return callbacks.get(e);
+        static void* GetComponent(int32_t typeID, uint32_t entityID, scene* _scene) {
+            entity e((entt::entity)entityID, _scene);
+            return get_component_callbacks(typeID).get(e);
         }
 
         static void GetGUID(uint32_t entityID, scene* _scene, guid* id) {
@@ -269,7 +334,7 @@ namespace sge {
             data->density = density;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static float GetFriction(collider_data* data) { return data->friction; }
@@ -278,7 +343,7 @@ namespace sge {
             data->friction = friction;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static float GetRestitution(collider_data* data) { return data->restitution; }
@@ -287,7 +352,7 @@ namespace sge {
             data->restitution = restitution;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static float GetRestitutionThreshold(collider_data* data) {
@@ -298,7 +363,7 @@ namespace sge {
             data->restitution_threshold = threshold;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static bool IsColliderSensor(collider_data* data) { return data->sensor; }
@@ -307,18 +372,19 @@ namespace sge {
             data->sensor = isSensor;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
 #pragma endregion
 #pragma region TagComponent
 
-        static void SetTag(tag_component* component, void* tag) {
-            component->tag = script_engine::from_managed_string(tag);
+        static void SetTag(tag_component* component, void* entity_object, void* tag) {
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->set_tag(_entity, script_engine::from_managed_string(tag));
         }
 
         static void* GetTag(tag_component* component) {
-            return script_engine::to_managed_string(component->tag);
+            return script_engine::get_interned_string(component->tag.get_handle());
         }
 
 #pragma endregion
@@ -328,22 +394,34 @@ namespace sge {
             *translation = component->translation;
         }
 
-        static void SetTranslation(transform_component* component, glm::vec2 translation) {
+        static void SetTranslation(transform_component* component, void* entity_object,
+                                   glm::vec2 translation) {
             component->translation = translation;
+
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->mark_physics_dirty(_entity);
         }
 
         static float GetRotation(transform_component* component) { return component->rotation; }
 
-        static void SetRotation(transform_component* component, float rotation) {
+        static void SetRotation(transform_component* component, void* entity_object,
+                                float rotation) {
             component->rotation = rotation;
+
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->mark_physics_dirty(_entity);
         }
 
         static void GetScale(transform_component* component, glm::vec2* scale) {
             *scale = component->scale;
         }
 
-        static void SetScale(transform_component* component, glm::vec2 scale) {
+        static void SetScale(transform_component* component, void* entity_object,
+                             glm::vec2 scale) {
             component->scale = scale;
+
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->mark_physics_dirty(_entity);
         }
 
         static int32_t GetZLayer(transform_component* component) { return component->z_layer; }
@@ -356,6 +434,16 @@ namespace sge {
             _entity.get_scene()->recalculate_render_order();
         }
 
+        // for changes made through TransformData
+        static void NotifyTransformChanged(void* entity_object, bool z_layer_changed) {
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->mark_physics_dirty(_entity);
+
+            if (z_layer_changed) {
+                _entity.get_scene()->recalculate_render_order();
+            }
+        }
+
 #pragma endregion
 #pragma region SpriteRendererComponent
 
@@ -368,20 +456,20 @@ namespace sge {
         }
 
         static void GetTexture(sprite_renderer_component* component, texture_2d** texture) {
-            *texture = component->texture.raw();
+            *texture = material_table::get(component->material).texture.raw();
         }
 
         static void SetTexture(sprite_renderer_component* component, texture_2d* texture) {
-            component->texture = texture;
+            component->material = material_table::with_texture(component->material, texture);
         }
 
         static void GetShader(sprite_renderer_component* component, shader** result) {
-            *result = component->_shader.raw();
+            *result = material_table::get(component->material)._shader.raw();
         }
 
         static void SetShader(sprite_renderer_component* component, void* entity_object,
                               shader* _shader) {
-            component->_shader = _shader;
+            component->material = material_table::with_shader(component->material, _shader);
 
             entity _entity = script_helpers::get_entity_from_object(entity_object);
             _entity.get_scene()->recalculate_render_order();
@@ -451,6 +539,10 @@ namespace sge {
             component->camera.set_perspective(fov, clips.near, clips.far);
         }
 
+        static void NotifyCameraChanged(camera_component* component) {
+            component->camera.recalculate_projection();
+        }
+
 #pragma endregion
 #pragma region RigidBodyComponent
 
@@ -463,7 +555,7 @@ namespace sge {
             rb->type = type;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static bool GetFixedRotation(rigid_body_component* rb) { return rb->fixed_rotation; }
@@ -472,7 +564,7 @@ namespace sge {
             rb->fixed_rotation = fixed_rotation;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static bool GetVelocity(void* _entity, glm::vec2* velocity) {
@@ -557,16 +649,29 @@ namespace sge {
             return component->filter_category;
         }
 
-        static void SetFilterCategory(rigid_body_component* component, uint16_t category) {
+        static void SetFilterCategory(rigid_body_component* component, void* _entity,
+                                      uint16_t category) {
             component->filter_category = category;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
         static uint16_t GetFilterMask(rigid_body_component* component) {
             return component->filter_mask;
         }
 
-        static void SetFilterMask(rigid_body_component* component, uint16_t mask) {
+        static void SetFilterMask(rigid_body_component* component, void* _entity, uint16_t mask) {
             component->filter_mask = mask;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->mark_physics_dirty(e);
+        }
+
+        // for changes made to the data of a rigid body or a collider directly
+        static void NotifyPhysicsChanged(void* _entity) {
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
 #pragma endregion
@@ -578,7 +683,7 @@ namespace sge {
             bc->size = size;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
 #pragma endregion
@@ -590,7 +695,7 @@ namespace sge {
             cc->radius = radius;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
 #pragma endregion
@@ -604,7 +709,7 @@ namespace sge {
             component->_shape = address;
 
             entity e = script_helpers::get_entity_from_object(_entity);
-            e.get_scene()->update_physics_data(e);
+            e.get_scene()->mark_physics_dirty(e);
         }
 
 #pragma endregion
@@ -672,12 +777,47 @@ namespace sge {
 #pragma region Input
 
         static bool GetKey(key_code key) { return input::get_key(key); }
+        static bool GetKeyPressed(key_code key) { return input::get_key_pressed(key); }
+        static bool GetKeyReleased(key_code key) { return input::get_key_released(key); }
+
         static bool GetMouseButton(mouse_button button) { return input::get_mouse_button(button); }
 
+        static bool GetMouseButtonPressed(mouse_button button) {
+            return input::get_mouse_button_pressed(button);
+        }
+
+        static bool GetMouseButtonReleased(mouse_button button) {
+            return input::get_mouse_button_released(button);
+        }
+
         static void GetMousePosition(glm::vec2* position) {
             *position = input::get_mouse_position();
         }
 
+        static uint32_t BindActionKey(void* name, key_code key) {
+            std::string native_name = script_engine::from_managed_string(name);
+            return input::bind_action(native_name, key);
+        }
+
+        static uint32_t BindActionMouseButton(void* name, mouse_button button) {
+            std::string native_name = script_engine::from_managed_string(name);
+            return input::bind_action(native_name, button);
+        }
+
+        static void ClearAction(void* name) {
+            std::string native_name = script_engine::from_managed_string(name);
+            input::clear_action(native_name);
+        }
+
+        static uint32_t GetActionID(void* name) {
+            std::string native_name = script_engine::from_managed_string(name);
+            return input::get_action_id(native_name);
+        }
+
+        static bool GetAction(uint32_t id) { return input::get_action(id); }
+        static bool GetActionPressed(uint32_t id) { return input::get_action_pressed(id); }
+        static bool GetActionReleased(uint32_t id) { return input::get_action_released(id); }
+
 #pragma endregion
 #pragma region Event
 
@@ -741,7 +881,7 @@ namespace sge {
             *button = address->get_button();
         }
 
-        static bool GetMouseButtonReleased(mouse_button_event* address) {
+        static bool GetEventMouseButtonReleased(mouse_button_event* address) {
             return address->get_released();
         }
 
@@ -852,6 +992,11 @@ namespace sge {
             return script_helpers::create_entity_object(e);
         }
 
+        static void* InstantiatePooledPrefab(prefab* _prefab, scene* _scene) {
+            entity e = _scene->instantiate_pooled(_prefab);
+            return script_helpers::create_entity_object(e);
+        }
+
 #pragma endregion
 #pragma region Sound
 
@@ -962,13 +1107,18 @@ namespace sge {
             REGISTER_FUNC(CreateEntityWithGUID);
             REGISTER_FUNC(CloneEntity);
             REGISTER_FUNC(DestroyEntity);
+            REGISTER_FUNC(ReleaseEntity);
+            REGISTER_FUNC(IsEntityActive);
             REGISTER_FUNC(FindEntity);
+            REGISTER_FUNC(FindEntityByTag);
             REGISTER_FUNC(ForEach);
             REGISTER_FUNC(GetCollisionCategoryName);
+            REGISTER_FUNC(QueryEntities);
 
 #pragma endregion
 #pragma region Entity
 
+            REGISTER_FUNC(GetComponentTypeID);
             REGISTER_FUNC(AddComponent);
             REGISTER_FUNC(HasComponent);
             REGISTER_FUNC(GetComponent);
@@ -1010,6 +1160,7 @@ namespace sge {
             REGISTER_FUNC(SetScale);
             REGISTER_FUNC(GetZLayer);
             REGISTER_FUNC(SetZLayer);
+            REGISTER_FUNC(NotifyTransformChanged);
 
 #pragma endregion
 #pragma region SpriteRendererComponent
@@ -1039,6 +1190,7 @@ namespace sge {
             REGISTER_FUNC(SetPerspectiveClips);
             REGISTER_FUNC(SetOrthographic);
             REGISTER_FUNC(SetPerspective);
+            REGISTER_FUNC(NotifyCameraChanged);
 
 #pragma endregion
 #pragma region RigidBodyComponent
@@ -1060,6 +1212,7 @@ namespace sge {
             REGISTER_FUNC(SetFilterCategory);
             REGISTER_FUNC(GetFilterMask);
             REGISTER_FUNC(SetFilterMask);
+            REGISTER_FUNC(NotifyPhysicsChanged);
 
 #pragma endregion
 #pragma region BoxColliderComponent
@@ -1100,8 +1253,19 @@ namespace sge {
 #pragma region Input
 
             REGISTER_FUNC(GetKey);
+            REGISTER_FUNC(GetKeyPressed);
+            REGISTER_FUNC(GetKeyReleased);
             REGISTER_FUNC(GetMouseButton);
+            REGISTER_FUNC(GetMouseButtonPressed);
+            REGISTER_FUNC(GetMouseButtonReleased);
             REGISTER_FUNC(GetMousePosition);
+            REGISTER_FUNC(BindActionKey);
+            REGISTER_FUNC(BindActionMouseButton);
+            REGISTER_FUNC(ClearAction);
+            REGISTER_FUNC(GetActionID);
+            REGISTER_FUNC(GetAction);
+            REGISTER_FUNC(GetActionPressed);
+            REGISTER_FUNC(GetActionReleased);
 
 #pragma endregion
 #pragma region Event
@@ -1145,7 +1309,7 @@ namespace sge {
 #pragma region MouseButtonEvent
 
             REGISTER_FUNC(GetEventMouseButton);
-            REGISTER_FUNC(GetMouseButtonReleased);
+            REGISTER_FUNC(GetEventMouseButtonReleased);
 
 #pragma endregion
 #pragma region FileChangedEvent
@@ -1184,6 +1348,7 @@ namespace sge {
             REGISTER_REF_COUNTER(prefab);
             REGISTER_FUNC(CreatePrefab);
             REGISTER_FUNC(InstantiatePrefab);
+            REGISTER_FUNC(InstantiatePooledPrefab);
 
 #pragma endregion
 #pragma region Sound
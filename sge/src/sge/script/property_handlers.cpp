@@ -267,7 +267,7 @@ namespace sge {
                     entity e = script_helpers::get_entity_from_object(entity_object);
 
                     if (e.has_all<tag_component>()) {
-                        tag = e.get_component<tag_component>().tag;
+                        tag = e.get_component<tag_component>().tag.str();
                     } else {
                         tag = "<no tag>";
                     }
@@ -386,60 +386,61 @@ namespace sge {
         s_handler_data.editor_scene = _scene;
     }
 
-    void script_helpers::show_property_control(void* instance, void* property,
-                                               const std::string& label) {
-        if (!is_property_serializable(property)) {
-            return;
-        }
+    bool script_helpers::has_property_handler(void* _class) {
+        return s_handler_data.callbacks.find(_class) != s_handler_data.callbacks.end();
+    }
 
-        void* _class = script_engine::get_property_type(property);
-        if (type_is_enum(_class)) {
-            handlers::edit_enum(instance, property, label);
+    void script_helpers::show_property_control(void* instance, const script_property& property,
+                                               const std::string& label) {
+        if (!property.serializable) {
             return;
         }
 
-        if (s_handler_data.callbacks.find(_class) == s_handler_data.callbacks.end()) {
+        switch (property.handler) {
+        case script_property_handler::enumeration:
+            handlers::edit_enum(instance, property.property, label);
+            break;
+        case script_property_handler::registered:
+            s_handler_data.callbacks.at(property.type).edit(instance, property.property, label);
+            break;
+        default:
             // type isn't supported yet
-            return;
+            break;
         }
-
-        s_handler_data.callbacks.at(_class).edit(instance, property, label);
     }
 
-    void script_helpers::serialize_property(void* instance, void* property, json& data) {
-        if (!is_property_serializable(property) || is_property_read_only(property)) {
-            return;
-        }
-
-        void* _class = script_engine::get_property_type(property);
-        void* object = script_engine::get_property_value(instance, property);
-        if (type_is_enum(_class)) {
-            handlers::serialize_enum(object, _class, data);
+    void script_helpers::serialize_property(void* instance, const script_property& property,
+                                            json& data) {
+        if (!property.serializable || property.read_only ||
+            property.handler == script_property_handler::none) {
             return;
         }
 
-        if (s_handler_data.callbacks.find(_class) == s_handler_data.callbacks.end()) {
-            return;
+        void* object = script_engine::get_property_value(instance, property.property);
+        if (property.handler == script_property_handler::enumeration) {
+            handlers::serialize_enum(object, property.type, data);
+        } else {
+            s_handler_data.callbacks.at(property.type).serialize(object, data);
         }
-
-        s_handler_data.callbacks.at(_class).serialize(object, data);
     }
 
-    void script_helpers::deserialize_property(void* instance, void* property, const json& data) {
-        if (!is_property_serializable(property) || is_property_read_only(property)) {
+    void script_helpers::deserialize_property(void* instance, const script_property& property,
+                                              const json& data) {
+        if (!property.serializable || property.read_only) {
             return;
         }
 
-        void* _class = script_engine::get_property_type(property);
-        if (type_is_enum(_class)) {
-            handlers::deserialize_enum(instance, property, data);
+        switch (property.handler) {
+        case script_property_handler::enumeration:
+            handlers::deserialize_enum(instance, property.property, data);
+            break;
+        case script_property_handler::registered:
+            s_handler_data.callbacks.at(property.type)
+                .deserialize(instance, property.property, data);
+            break;
+        default:
+            break;
         }
-
-        if (s_handler_data.callbacks.find(_class) == s_handler_data.callbacks.end()) {
-            return;
-        }
-
-        s_handler_data.callbacks.at(_class).deserialize(instance, property, data);
     }
 
     static void register_property_handler(const std::string& managed,
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/script/script_callbacks.h"
+#include "sge/script/script_engine.h"
+#include "sge/script/script_helpers.h"
+
+namespace sge {
+    // only touched from the thread running scripts
+    static std::unordered_map<void*, script_callbacks> s_callbacks;
+
+    static script_callbacks resolve_callbacks(void* _class) {
+        script_callbacks callbacks;
+
+        callbacks.has_constructor = script_engine::get_method(_class, ".ctor") != nullptr;
+        if (callbacks.has_constructor) {
+            callbacks.constructor = script_engine::get_method(_class, ".ctor()");
+        }
+
+        callbacks.entity_field = script_engine::get_field(_class, "__internal_mEntity");
+
+        callbacks.on_start = script_engine::get_method(_class, "OnStart()");
+        callbacks.on_stop = script_engine::get_method(_class, "OnStop()");
+        callbacks.on_update = script_engine::get_method(_class, "OnUpdate(Timestep)");
+
+        callbacks.on_event = script_engine::get_method(_class, "OnEvent(Event)");
+        callbacks.on_events = script_engine::get_method(_class, "OnEvents(Event[])");
+        if (callbacks.on_event != nullptr || callbacks.on_events != nullptr) {
+            callbacks.event_mask = script_helpers::get_event_subscription_mask(_class);
+        }
+
+        callbacks.on_collision = script_engine::get_method(_class, "OnCollision(Entity,Vector2)");
+        callbacks.collision_takes_normal = callbacks.on_collision != nullptr;
+        if (!callbacks.collision_takes_normal) {
+            callbacks.on_collision = script_engine::get_method(_class, "OnCollision(Entity)");
+        }
+
+        callbacks.on_collision_end = script_engine::get_method(_class, "OnCollisionEnd(Entity)");
+
+        auto& thunks = callbacks.thunks;
+        thunks.on_start = script_engine::get_method_thunk(callbacks.on_start);
+        thunks.on_stop = script_engine::get_method_thunk(callbacks.on_stop);
+        thunks.on_update = script_engine::get_method_thunk(callbacks.on_update);
+        thunks.on_event = script_engine::get_method_thunk(callbacks.on_event);
+        thunks.on_events = script_engine::get_method_thunk(callbacks.on_events);
+        thunks.on_collision_end = script_engine::get_method_thunk(callbacks.on_collision_end);
+
+        if (!callbacks.collision_takes_normal) {
+            thunks.on_collision = script_engine::get_method_thunk(callbacks.on_collision);
+        }
+
+        return callbacks;
+    }
+
+    const script_callbacks& script_callback_cache::get(void* _class) {
+        auto it = s_callbacks.find(_class);
+        if (it == s_callbacks.end()) {
+            it = s_callbacks.insert(std::make_pair(_class, resolve_callbacks(_class))).first;
+        }
+
+        return it->second;
+    }
+
+    void script_callback_cache::clear() { s_callbacks.clear(); }
+} // namespace sge
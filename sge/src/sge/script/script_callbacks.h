@@ -0,0 +1,66 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+namespace sge {
+    // Methods the engine calls on script instances. Methods a class doesn't define are null.
+    struct script_callbacks {
+        // ".ctor()", or null if the class only has constructors that take arguments
+        void* constructor = nullptr;
+        bool has_constructor = false;
+
+        // Entity.__internal_mEntity
+        void* entity_field = nullptr;
+
+        void* on_start = nullptr;
+        void* on_stop = nullptr;
+        void* on_update = nullptr;
+
+        void* on_event = nullptr;
+        void* on_events = nullptr;
+
+        // 0 if the class handles no events
+        uint32_t event_mask = 0;
+
+        // either OnCollision(Entity,Vector2) or OnCollision(Entity)
+        void* on_collision = nullptr;
+        bool collision_takes_normal = false;
+        void* on_collision_end = nullptr;
+
+        // unmanaged thunks of the callbacks above, called through script_engine::call_thunk.
+        // OnCollision(Entity,Vector2) has none, as the normal would have to be boxed
+        struct {
+            void* on_start = nullptr;
+            void* on_stop = nullptr;
+            void* on_update = nullptr;
+            void* on_event = nullptr;
+            void* on_events = nullptr;
+            void* on_collision = nullptr;
+            void* on_collision_end = nullptr;
+        } thunks;
+    };
+
+    // Resolves the callbacks of each script class once, so that the frame loop doesn't have to
+    // look methods up by name. The cache is cleared whenever the script domain is unloaded, as
+    // class pointers don't survive it.
+    class script_callback_cache {
+    public:
+        script_callback_cache() = delete;
+
+        static const script_callbacks& get(void* _class);
+        static void clear();
+    };
+} // namespace sge
@@ -20,6 +20,8 @@
 #include "sge/script/mono_include.h"
 #include "sge/script/garbage_collector.h"
 #include "sge/script/script_helpers.h"
+#include "sge/script/script_callbacks.h"
+#include "sge/script/script_properties.h"
 #include "sge/script/value_wrapper.h"
 #include "sge/scene/components.h"
 #include "sge/core/environment.h"
@@ -44,6 +46,8 @@ namespace sge {
 
         bool reload_callbacks_locked = false;
         std::vector<std::optional<std::function<void()>>> reload_callbacks;
+
+        std::unordered_map<string_handle, ref<object_ref>> interned_strings;
     };
 
     static std::unique_ptr<script_engine_data_t> script_engine_data;
@@ -206,6 +210,11 @@ namespace sge {
     }
 
     static void script_engine_shutdown_internal() {
+        script_engine_data->interned_strings.clear();
+        script_callback_cache::clear();
+        script_property_cache::clear();
+        script_helpers::shutdown();
+
         garbage_collector::shutdown();
         mono_domain_set(script_engine_data->root_domain, false);
         mono_domain_unload(script_engine_data->script_domain);
@@ -416,6 +425,8 @@ namespace sge {
 
         void* asset_class = script_helpers::get_core_type("SGE.Asset", true);
         for (ref<scene> _scene : current_scenes) {
+            _scene->reset_script_runner();
+
             std::unordered_map<guid, std::unordered_map<std::string, script_property_data_t>>
                 entity_data;
 
@@ -428,21 +439,20 @@ namespace sge {
                 void* _class = sc._class;
                 void* instance = sc.instance->get();
 
-                std::vector<void*> properties;
-                iterate_properties(_class, properties);
+                const auto& properties = script_property_cache::get(_class);
 
                 std::unordered_map<std::string, script_property_data_t> property_values;
-                for (void* property : properties) {
-                    if (!script_helpers::is_property_serializable(property)) {
+                for (const auto& descriptor : properties) {
+                    if (!descriptor.serializable) {
                         continue;
                     }
 
                     script_property_data_t result;
-                    void* type = get_property_type(property);
+                    void* type = descriptor.type;
                     result.type_name = script_helpers::get_type_name_safe(type);
 
-                    void* property_data = get_property_value(instance, property);
-                    if (is_value_type(type)) {
+                    void* property_data = get_property_value(instance, descriptor.property);
+                    if (descriptor.value_type) {
                         size_t size = script_helpers::get_type_size(type);
 
                         const void* unboxed = unbox_object(property_data);
@@ -524,8 +534,7 @@ namespace sge {
                         }
                     }
 
-                    std::string name = get_property_name(property);
-                    property_values.insert(std::make_pair(name, result));
+                    property_values.insert(std::make_pair(descriptor.name, result));
                 }
 
                 guid id = e.get_guid();
@@ -565,7 +574,7 @@ namespace sge {
                 if (sc._class == nullptr) {
                     spdlog::warn(
                         "between reloads, script class {0} was deleted - deleting script data",
-                        sc.class_name);
+                        sc.class_name.str());
 
                     continue;
                 }
@@ -574,15 +583,16 @@ namespace sge {
                 void* script_object = sc.instance->get();
 
                 for (const auto& [property_name, data] : property_values) {
-                    void* property = get_property(sc._class, property_name);
-                    if (property == nullptr) {
+                    const auto* descriptor = script_property_cache::find(sc._class, property_name);
+                    if (descriptor == nullptr) {
                         spdlog::warn("between reloads, script property {0}.{1} was deleted - "
                                      "deleting its data",
-                                     sc.class_name, property_name);
+                                     sc.class_name.str(), property_name);
 
                         continue;
                     }
 
+                    void* property = descriptor->property;
                     switch (data.property_type) {
                     case script_property_type::array: {
                         auto mono_element_type = (MonoClass*)data.array_element_type;
@@ -821,6 +831,11 @@ namespace sge {
         return mono_object_unbox(mono_object);
     }
 
+    void* script_engine::box_value(void* _class, const void* value) {
+        auto mono_class = (MonoClass*)_class;
+        return mono_value_box(script_engine_data->script_domain, mono_class, (void*)value);
+    }
+
     size_t script_engine::get_array_length(void* array) {
         auto mono_array = (MonoArray*)array;
         return (size_t)mono_array_length(mono_array);
@@ -850,6 +865,29 @@ namespace sge {
         }
     }
 
+    void* script_engine::create_array(void* element_type, size_t length) {
+        auto mono_class = (MonoClass*)element_type;
+        return mono_array_new(script_engine_data->script_domain, mono_class, (uintptr_t)length);
+    }
+
+    void script_engine::set_array_element(void* array, size_t index, void* value) {
+        void* array_type = get_class_from_object(array);
+        auto mono_class = (MonoClass*)array_type;
+
+        MonoClass* element_type = mono_class_get_element_class(mono_class);
+        auto mono_array = (MonoArray*)array;
+
+        if (mono_class_is_valuetype(element_type)) {
+            int32_t element_size = mono_array_element_size(mono_class);
+            void* ptr = mono_array_addr_with_size(mono_array, element_size, (uintptr_t)index);
+
+            // the structure may hold references, so the gc needs to know about the copy
+            mono_gc_wbarrier_value_copy(ptr, value, 1, element_type);
+        } else {
+            mono_array_setref(mono_array, (uintptr_t)index, (MonoObject*)value);
+        }
+    }
+
     void* script_engine::get_method(void* _class, const std::string& name) {
         std::string method_desc = "*:" + name;
         auto mono_desc = mono_method_desc_new(method_desc.c_str(), false);
@@ -962,6 +1000,15 @@ namespace sge {
         return returned;
     }
 
+    void* script_engine::get_method_thunk(void* method) {
+        if (method == nullptr) {
+            return nullptr;
+        }
+
+        auto mono_method = (MonoMethod*)method;
+        return mono_method_get_unmanaged_thunk(mono_method);
+    }
+
     void* script_engine::call_delegate(void* delegate, void** arguments) {
         if (delegate == nullptr) {
             throw std::runtime_error("attempted to call nullptr!");
@@ -1089,6 +1136,20 @@ namespace sge {
         return mono_string_to_utf8(mono_string);
     }
 
+    void* script_engine::get_interned_string(string_handle handle) {
+        auto& strings = script_engine_data->interned_strings;
+
+        auto it = strings.find(handle);
+        if (it == strings.end()) {
+            void* managed_string = to_managed_string(string_pool::get(handle));
+            auto gc_ref = object_ref::from_object(managed_string);
+
+            it = strings.insert(std::make_pair(handle, gc_ref)).first;
+        }
+
+        return it->second->get();
+    }
+
     void* script_engine::to_reflection_type(void* _class) {
         auto mono_class = (MonoClass*)_class;
         auto type = mono_class_get_type(mono_class);
@@ -17,6 +17,13 @@
 #pragma once
 #include "sge/scene/scene.h"
 
+// calling convention of the thunks returned by script_engine::get_method_thunk
+#ifdef SGE_PLATFORM_WINDOWS
+#define SGE_THUNK_CALL __stdcall
+#else
+#define SGE_THUNK_CALL
+#endif
+
 namespace sge {
     struct class_name_t {
         std::string namespace_name, class_name;
@@ -123,6 +130,7 @@ namespace sge {
         static void* clone_object(void* original);
         static void init_object(void* object);
         static const void* unbox_object(void* object);
+        static void* box_value(void* _class, const void* value);
 
         template <typename T>
         static const T& unbox_object(void* object) {
@@ -134,6 +142,11 @@ namespace sge {
         static void* get_array_element_type(void* array);
         static void* get_array_element(void* array, size_t index);
 
+        static void* create_array(void* element_type, size_t length);
+
+        // value type elements are passed unboxed
+        static void set_array_element(void* array, size_t index, void* value);
+
         static void* get_method(void* _class, const std::string& name);
         static std::string get_method_name(void* method);
         static void* get_method_return_type(void* method);
@@ -148,18 +161,42 @@ namespace sge {
 
         template <typename... Args>
         static void* call_method(void* object, void* method, Args*... args) {
-            std::vector<void*> args_vector = { std::forward<Args*>(args)... };
-            void** arguments = args_vector.empty() ? nullptr : args_vector.data();
-
-            return call_method(object, method, arguments);
+            // the extra element keeps the array from being empty
+            void* arguments[sizeof...(Args) + 1] = { (void*)args..., nullptr };
+            return call_method(object, method, sizeof...(Args) > 0 ? arguments : nullptr);
         }
-        
+
         template <typename... Args>
         static void* call_delegate(void* delegate, Args*... args) {
-            std::vector<void*> args_vector = { std::forward<Args*>(args)... };
-            void** arguments = args_vector.empty() ? nullptr : args_vector.data();
+            void* arguments[sizeof...(Args) + 1] = { (void*)args..., nullptr };
+            return call_delegate(delegate, sizeof...(Args) > 0 ? arguments : nullptr);
+        }
 
-            return call_delegate(delegate, arguments);
+        // returns a native function pointer that calls the method without going through
+        // call_method. the pointer takes the instance first (unless the method is static), then
+        // the arguments, and an exception out-parameter last. value type arguments other than
+        // primitives are passed boxed
+        static void* get_method_thunk(void* method);
+
+        // the argument types must match the managed signature, as described above
+        template <typename R = void, typename... Args>
+        static R call_thunk(void* thunk, Args... args) {
+            if (thunk == nullptr) {
+                throw std::runtime_error("attempted to call nullptr!");
+            }
+
+            using thunk_t = R(SGE_THUNK_CALL*)(Args..., void**);
+            void* exception = nullptr;
+
+            if constexpr (std::is_void_v<R>) {
+                ((thunk_t)thunk)(args..., &exception);
+                handle_exception(exception);
+            } else {
+                R returned = ((thunk_t)thunk)(args..., &exception);
+                handle_exception(exception);
+
+                return returned;
+            }
         }
 
         static void* get_property(void* _class, const std::string& name);
@@ -179,6 +216,9 @@ namespace sge {
         static void* to_managed_string(const std::string& native_string);
         static std::string from_managed_string(void* managed_string);
 
+        // managed strings are immutable, so one object is shared per interned string
+        static void* get_interned_string(string_handle handle);
+
         static void* to_reflection_type(void* _class);
         static void* from_reflection_type(void* reflection_type);
 
@@ -19,12 +19,72 @@
 #include "sge/script/script_engine.h"
 
 namespace sge {
+    struct scene_objects_t {
+        ref<object_ref> scene_object;
+
+        // weak, so that entities nothing refers to can still be collected
+        std::unordered_map<entt::entity, ref<object_ref>> entity_objects;
+    };
+
+    struct wrapper_data_t {
+        void* scene_class;
+        void* scene_constructor;
+        void* scene_address_field;
+
+        void* entity_class;
+        void* entity_constructor;
+        void* entity_id_field;
+        void* entity_scene_field;
+
+        std::unordered_map<scene*, scene_objects_t> scenes;
+    };
+
     static void* managed_helpers_class = nullptr;
+    static wrapper_data_t wrapper_data;
+
+    // called for every event that is dispatched to managed scripts
+    static void* create_event_method = nullptr;
+
     void script_helpers::init() {
         managed_helpers_class = get_core_type("SGE.Helpers", true);
         register_property_handlers();
+
+        create_event_method = script_engine::get_method(managed_helpers_class, "CreateEvent");
+        if (create_event_method == nullptr) {
+            throw std::runtime_error("could not find SGE.Helpers.CreateEvent!");
+        }
+
+        wrapper_data.scene_class = get_core_type("SGE.Scene", true);
+        if (wrapper_data.scene_class == nullptr) {
+            throw std::runtime_error("could not find SGE.Scene!");
+        }
+
+        wrapper_data.scene_constructor =
+            script_engine::get_method(wrapper_data.scene_class, ".ctor");
+        if (wrapper_data.scene_constructor == nullptr) {
+            throw std::runtime_error("could not find the Scene object constructor!");
+        }
+
+        wrapper_data.entity_class = get_core_type("SGE.Entity", true);
+        if (wrapper_data.entity_class == nullptr) {
+            throw std::runtime_error("could not find SGE.Entity!");
+        }
+
+        wrapper_data.entity_constructor =
+            script_engine::get_method(wrapper_data.entity_class, ".ctor");
+        if (wrapper_data.entity_constructor == nullptr) {
+            throw std::runtime_error("could not find the Entity object constructor!");
+        }
+
+        wrapper_data.scene_address_field =
+            script_engine::get_field(wrapper_data.scene_class, "mNativeAddress");
+        wrapper_data.entity_id_field = script_engine::get_field(wrapper_data.entity_class, "mID");
+        wrapper_data.entity_scene_field =
+            script_engine::get_field(wrapper_data.entity_class, "mScene");
     }
 
+    void script_helpers::shutdown() { wrapper_data.scenes.clear(); }
+
     void* script_helpers::get_class() { return managed_helpers_class; }
 
     void script_helpers::report_exception(void* exception) {
@@ -120,69 +180,76 @@ namespace sge {
         return (accessors & property_accessor_set) == property_accessor_none;
     }
 
-    void* script_helpers::create_entity_object(entity e) {
-        if (!e) {
-            return nullptr;
-        }
+    static scene_objects_t& get_scene_objects(scene* _scene) {
+        auto& objects = wrapper_data.scenes[_scene];
+        if (!objects.scene_object) {
+            void* scene_instance = script_engine::alloc_object(wrapper_data.scene_class);
+            script_engine::call_method(scene_instance, wrapper_data.scene_constructor, &_scene);
 
-        void* scriptcore = script_engine::get_assembly(0);
-        void* scene_class = script_engine::get_class(scriptcore, "SGE.Scene");
-        if (scene_class == nullptr) {
-            throw std::runtime_error("could not find SGE.Scene!");
+            objects.scene_object = object_ref::from_object(scene_instance);
         }
 
-        void* scene_constructor = script_engine::get_method(scene_class, ".ctor");
-        if (scene_constructor == nullptr) {
-            throw std::runtime_error("could not find the Scene object constructor!");
-        }
+        return objects;
+    }
 
-        scene* _scene = e.get_scene();
+    void* script_helpers::get_scene_object(scene* _scene) {
+        if (_scene == nullptr) {
+            return nullptr;
+        }
 
-        void* scene_instance = script_engine::alloc_object(scene_class);
-        script_engine::call_method(scene_instance, scene_constructor, &_scene);
+        return get_scene_objects(_scene).scene_object->get();
+    }
 
-        void* entity_class = script_engine::get_class(scriptcore, "SGE.Entity");
-        if (entity_class == nullptr) {
-            throw std::runtime_error("could not find SGE.Entity!");
+    void* script_helpers::create_entity_object(entity e) {
+        if (!e) {
+            return nullptr;
         }
 
-        void* entity_constructor = script_engine::get_method(entity_class, ".ctor");
-        if (entity_constructor == nullptr) {
-            throw std::runtime_error("could not find the Entity object constructor!");
+        auto& objects = get_scene_objects(e.get_scene());
+        auto& entity_object = objects.entity_objects[e];
+
+        // the weak handle is emptied once the object has been collected
+        if (entity_object) {
+            void* entity_instance = entity_object->get();
+            if (entity_instance != nullptr) {
+                return entity_instance;
+            }
         }
 
         uint32_t id = (uint32_t)e;
+        void* scene_instance = objects.scene_object->get();
+
+        void* entity_instance = script_engine::alloc_object(wrapper_data.entity_class);
+        script_engine::call_method(entity_instance, wrapper_data.entity_constructor, &id,
+                                   scene_instance);
 
-        void* entity_instance = script_engine::alloc_object(entity_class);
-        script_engine::call_method(entity_instance, entity_constructor, &id, scene_instance);
+        entity_object = object_ref::from_object(entity_instance, true);
         return entity_instance;
     }
 
+    void script_helpers::release_entity_object(entity e) {
+        auto it = wrapper_data.scenes.find(e.get_scene());
+        if (it != wrapper_data.scenes.end()) {
+            it->second.entity_objects.erase(e);
+        }
+    }
+
+    void script_helpers::release_scene_objects(scene* _scene) {
+        wrapper_data.scenes.erase(_scene);
+    }
+
     entity script_helpers::get_entity_from_object(void* object) {
         if (object == nullptr) {
             return entity();
         }
 
-        void* scriptcore = script_engine::get_assembly(0);
-        void* entity_class = script_engine::get_class(scriptcore, "SGE.Entity");
-        if (entity_class == nullptr) {
-            throw std::runtime_error("could not find SGE.Entity!");
-        }
-
-        void* field = script_engine::get_field(entity_class, "mID");
-        void* value = script_engine::get_field_value(object, field);
+        void* value = script_engine::get_field_value(object, wrapper_data.entity_id_field);
         uint32_t entity_id = script_engine::unbox_object<uint32_t>(value);
 
-        field = script_engine::get_field(entity_class, "mScene");
-        void* scene_object = script_engine::get_field_value(object, field);
+        void* scene_object =
+            script_engine::get_field_value(object, wrapper_data.entity_scene_field);
 
-        void* scene_class = script_engine::get_class(scriptcore, "SGE.Scene");
-        if (scene_class == nullptr) {
-            throw std::runtime_error("could not find SGE.Scene!");
-        }
-
-        field = script_engine::get_field(scene_class, "mNativeAddress");
-        value = script_engine::get_field_value(scene_object, field);
+        value = script_engine::get_field_value(scene_object, wrapper_data.scene_address_field);
         scene* _scene = script_engine::unbox_object<scene*>(value);
 
         return entity((entt::entity)entity_id, _scene);
@@ -276,12 +343,18 @@ namespace sge {
     }
 
     void* script_helpers::create_event_object(event& e) {
-        void* method = script_engine::get_method(managed_helpers_class, "CreateEvent");
-
         event_id id = e.get_id();
         void* ptr = &e;
 
-        return script_engine::call_method(nullptr, method, &ptr, &id);
+        return script_engine::call_method(nullptr, create_event_method, &ptr, &id);
+    }
+
+    uint32_t script_helpers::get_event_subscription_mask(void* _class) {
+        void* method = script_engine::get_method(managed_helpers_class, "GetEventSubscriptionMask");
+        void* reflection_type = script_engine::to_reflection_type(_class);
+
+        void* returned = script_engine::call_method(nullptr, method, reflection_type);
+        return (uint32_t)script_engine::unbox_object<int32_t>(returned);
     }
 
     void* script_helpers::create_list_object(void* element_type) {
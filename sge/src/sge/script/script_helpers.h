@@ -20,6 +20,7 @@
 #include "sge/asset/json.h"
 #include "sge/asset/asset.h"
 #include "sge/script/garbage_collector.h"
+#include "sge/script/script_properties.h"
 
 namespace sge {
     class script_helpers {
@@ -27,6 +28,7 @@ namespace sge {
         script_helpers() = delete;
 
         static void init();
+        static void shutdown();
         static void* get_class();
 
         static void report_exception(void* exception);
@@ -40,8 +42,14 @@ namespace sge {
         static bool is_property_serializable(void* property);
         static bool is_property_read_only(void* property);
 
+        // Scene objects are cached for as long as the scene exists, and Entity objects for as
+        // long as something in managed code refers to them
         static void* create_entity_object(entity e);
         static entity get_entity_from_object(void* object);
+        static void* get_scene_object(scene* _scene);
+
+        static void release_entity_object(entity e);
+        static void release_scene_objects(scene* _scene);
 
         static void* create_asset_object(ref<asset> _asset);
         static ref<asset> get_asset_from_object(void* object);
@@ -56,13 +64,20 @@ namespace sge {
         static bool type_extends(void* derived, void* base);
         
         static void* create_event_object(event& e);
+
+        // bit n is set if scripts of the class receive events with the id n
+        static uint32_t get_event_subscription_mask(void* _class);
         static void* create_list_object(void* element_type);
 
         static void set_editor_scene(ref<scene> _scene);
-        static void show_property_control(void* instance, void* property, const std::string& label);
-
-        static void serialize_property(void* instance, void* property, json& data);
-        static void deserialize_property(void* instance, void* property, const json& data);
+        static bool has_property_handler(void* _class);
+        static void show_property_control(void* instance, const script_property& property,
+                                          const std::string& label);
+
+        static void serialize_property(void* instance, const script_property& property,
+                                       json& data);
+        static void deserialize_property(void* instance, const script_property& property,
+                                         const json& data);
 
     private:
         static void register_property_handlers();
@@ -0,0 +1,102 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/script/script_properties.h"
+#include "sge/script/script_engine.h"
+#include "sge/script/script_helpers.h"
+
+namespace sge {
+    // only touched from the thread running scripts
+    static std::unordered_map<void*, std::vector<script_property>> s_properties;
+
+    static void get_section_headers(void* property, std::vector<std::string>& headers) {
+        void* attribute_type = script_helpers::get_core_type("SGE.SectionHeaderAttribute", true);
+        if (attribute_type == nullptr ||
+            !script_helpers::property_has_attribute(property, attribute_type)) {
+            headers.push_back("");
+            return;
+        }
+
+        void* header_names_property = script_engine::get_property(attribute_type, "HeaderNames");
+        auto attribute = script_helpers::get_property_attribute(property, attribute_type);
+
+        void* list = script_engine::get_property_value(attribute->get(), header_names_property);
+        void* list_type = script_engine::get_class_from_object(list);
+
+        void* count_property = script_engine::get_property(list_type, "Count");
+        void* returned = script_engine::get_property_value(list, count_property);
+        int32_t count = script_engine::unbox_object<int32_t>(returned);
+
+        void* item_property = script_engine::get_property(list_type, "Item");
+        for (int32_t i = 0; i < count; i++) {
+            returned = script_engine::get_property_value(list, item_property, &i);
+            headers.push_back(script_engine::from_managed_string(returned));
+        }
+    }
+
+    static std::vector<script_property> resolve_properties(void* _class) {
+        std::vector<void*> properties;
+        script_engine::iterate_properties(_class, properties);
+
+        std::vector<script_property> result;
+        for (void* property : properties) {
+            auto& descriptor = result.emplace_back();
+            descriptor.property = property;
+            descriptor.name = script_engine::get_property_name(property);
+
+            descriptor.type = script_engine::get_property_type(property);
+            descriptor.value_type = script_engine::is_value_type(descriptor.type);
+
+            descriptor.serializable = script_helpers::is_property_serializable(property);
+            descriptor.read_only = script_helpers::is_property_read_only(property);
+
+            if (script_helpers::type_is_enum(descriptor.type)) {
+                descriptor.handler = script_property_handler::enumeration;
+            } else if (script_helpers::has_property_handler(descriptor.type)) {
+                descriptor.handler = script_property_handler::registered;
+            }
+
+            // only the editor cares about headers, and only for properties it shows
+            if (descriptor.serializable) {
+                get_section_headers(property, descriptor.section_headers);
+            }
+        }
+
+        return result;
+    }
+
+    const std::vector<script_property>& script_property_cache::get(void* _class) {
+        auto it = s_properties.find(_class);
+        if (it == s_properties.end()) {
+            it = s_properties.insert(std::make_pair(_class, resolve_properties(_class))).first;
+        }
+
+        return it->second;
+    }
+
+    const script_property* script_property_cache::find(void* _class, const std::string& name) {
+        for (const auto& property : get(_class)) {
+            if (property.name == name) {
+                return &property;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void script_property_cache::clear() { s_properties.clear(); }
+} // namespace sge
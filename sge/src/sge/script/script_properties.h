@@ -0,0 +1,55 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+namespace sge {
+    // how values of a property are edited and serialized
+    enum class script_property_handler { none, enumeration, registered };
+
+    // What the engine needs to know about a property of a script class.
+    struct script_property {
+        void* property = nullptr;
+        std::string name;
+
+        void* type = nullptr;
+        bool value_type = false;
+
+        // public, has a getter, and isn't marked with UnserializedAttribute
+        bool serializable = false;
+        bool read_only = false;
+
+        script_property_handler handler = script_property_handler::none;
+
+        // SectionHeaderAttribute.HeaderNames, or a single empty name if there is no attribute
+        std::vector<std::string> section_headers;
+    };
+
+    // Resolves the properties of each script class once, so that serializing, copying, and
+    // editing scripts doesn't have to go through reflection for every property of every entity.
+    // The cache is cleared whenever the script domain is unloaded, as class pointers don't
+    // survive it.
+    class script_property_cache {
+    public:
+        script_property_cache() = delete;
+
+        static const std::vector<script_property>& get(void* _class);
+
+        // null if the class has no property with the given name
+        static const script_property* find(void* _class, const std::string& name);
+
+        static void clear();
+    };
+} // namespace sge
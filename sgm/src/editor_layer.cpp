@@ -49,6 +49,11 @@ namespace sgm {
         }
 
         editor_scene::on_update(ts);
+
+        // garbage collection can wait until nothing is running
+        if (!editor_scene::running()) {
+            garbage_collector::mark_idle_frame();
+        }
     }
 
     void editor_layer::on_event(event& e) {
@@ -20,6 +20,7 @@
 #include <sge/renderer/renderer.h>
 #include <sge/asset/sound.h>
 #include <sge/script/garbage_collector.h>
+#include <sge/scene/scene_snapshot.h>
 
 namespace sgm {
     struct scene_data_t {
@@ -128,7 +129,16 @@ namespace sgm {
 
         reset_selection();
 
-        s_scene_data->runtime_scene = s_scene_data->_scene->copy();
+        // the runtime scene is rebuilt from a snapshot, so that play mode never touches the
+        // edited scene
+        auto snapshot = s_scene_data->_scene->snapshot();
+        auto _framebuffer = s_scene_data->_framebuffer;
+
+        s_scene_data->runtime_scene = ref<scene>::create();
+        s_scene_data->runtime_scene->set_viewport_size(_framebuffer->get_width(),
+                                                       _framebuffer->get_height());
+
+        s_scene_data->runtime_scene->restore(snapshot);
         s_scene_data->runtime_scene->on_start();
 
         script_helpers::set_editor_scene(s_scene_data->runtime_scene);
@@ -143,7 +153,7 @@ namespace sgm {
         script_helpers::set_editor_scene(s_scene_data->_scene);
 
         sound::stop_all();
-        garbage_collector::collect(false);
+        garbage_collector::request_full_collection();
 
         s_scene_data->runtime_scene->on_stop();
         s_scene_data->runtime_scene.reset();
@@ -446,7 +446,7 @@ namespace sgm {
                         throw std::runtime_error("invalid guid passed!");
                     }
 
-                    std::string tag = e.get_component<tag_component>().tag;
+                    std::string tag = e.get_component<tag_component>().tag.str();
                     if (tag.empty()) {
                         tag = "Entity";
                     }
@@ -221,8 +221,10 @@ namespace sgm {
             return false;
         }
 
-        auto& tag = target.get_component<tag_component>();
-        ImGui::InputText("##entity-tag", &tag.tag);
+        std::string tag = target.get_component<tag_component>().tag.str();
+        if (ImGui::InputText("##entity-tag", &tag)) {
+            target.get_scene()->set_tag(target, tag);
+        }
 
         ImGui::SameLine();
         ImGui::PushItemWidth(-1.f);
@@ -259,9 +261,14 @@ namespace sgm {
 
         draw_component<transform_component>(
             "Transform", target, [target](transform_component& transform) {
-                ImGui::DragFloat2("Translation", &transform.translation.x, 0.25f);
-                ImGui::DragFloat("Rotation", &transform.rotation);
-                ImGui::DragFloat2("Scale", &transform.scale.x, 0.5f);
+                bool update = false;
+                update |= ImGui::DragFloat2("Translation", &transform.translation.x, 0.25f);
+                update |= ImGui::DragFloat("Rotation", &transform.rotation);
+                update |= ImGui::DragFloat2("Scale", &transform.scale.x, 0.5f);
+
+                if (update) {
+                    target.get_scene()->mark_physics_dirty(target);
+                }
 
                 if (ImGui::InputInt("Z layer", &transform.z_layer)) {
                     target.get_scene()->recalculate_render_order();
@@ -314,15 +321,18 @@ namespace sgm {
             "Sprite renderer", target, [this, target](sprite_renderer_component& component) {
                 ImGui::ColorEdit4("Color", &component.color.x);
 
-                ref<asset> _asset = component.texture;
+                const auto& material = material_table::get(component.material);
+                ref<asset> _asset = material.texture;
                 if (ImGui::InputAsset("Texture", &_asset, "texture", "texture_2d")) {
-                    component.texture = _asset.as<texture_2d>();
+                    component.material =
+                        material_table::with_texture(component.material, _asset.as<texture_2d>());
                 }
 
                 static const std::string shader_name = "shader";
-                _asset = component._shader;
+                _asset = material_table::get(component.material)._shader;
                 if (ImGui::InputAsset("Shader", &_asset, shader_name, shader_name)) {
-                    component._shader = _asset.as<shader>();
+                    component.material =
+                        material_table::with_shader(component.material, _asset.as<shader>());
                     target.get_scene()->recalculate_render_order();
                 }
             });
@@ -341,7 +351,7 @@ namespace sgm {
 
             update |= ImGui::Checkbox("Fixed rotation", &component.fixed_rotation);
             if (update && running) {
-                target.get_scene()->update_physics_data(target);
+                target.get_scene()->mark_physics_dirty(target);
             }
 
             if (ImGui::CollapsingHeader("Collision filter")) {
@@ -380,7 +390,7 @@ namespace sgm {
                 update |= ImGui::DragFloat2("Size", &component.size.x, 0.01f);
 
                 if (update && running) {
-                    target.get_scene()->update_physics_data(target);
+                    target.get_scene()->mark_physics_dirty(target);
                 }
             });
 
@@ -392,7 +402,7 @@ namespace sgm {
                 update |= ImGui::DragFloat("Radius", &component.radius, 0.01f);
 
                 if (update && running) {
-                    target.get_scene()->update_physics_data(target);
+                    target.get_scene()->mark_physics_dirty(target);
                 }
             });
 
@@ -407,7 +417,7 @@ namespace sgm {
                 }
 
                 if (update && running) {
-                    target.get_scene()->update_physics_data(target);
+                    target.get_scene()->mark_physics_dirty(target);
                 }
             });
 
@@ -429,19 +439,21 @@ namespace sgm {
                     return _class != nullptr;
                 };
 
-                bool valid_script = is_class_valid(component.class_name);
+                std::string class_name = component.class_name.str();
+                bool valid_script = is_class_valid(class_name);
                 bool invalid_name = !valid_script;
 
                 if (invalid_name) {
                     ImGui::PushStyleColor(ImGuiCol_Text, script_error_color);
                 }
 
-                if (ImGui::InputText("Script Name", &component.class_name)) {
-                    valid_script = is_class_valid(component.class_name);
+                if (ImGui::InputText("Script Name", &class_name)) {
+                    component.class_name = class_name;
+                    valid_script = is_class_valid(class_name);
 
                     auto _scene = editor_scene::get_scene();
                     if (valid_script) {
-                        void* _class = script_engine::get_class(assembly, component.class_name);
+                        void* _class = script_engine::get_class(assembly, class_name);
                         _scene->set_script(target, _class);
                     } else {
                         _scene->set_script(target, nullptr);
@@ -473,43 +485,16 @@ namespace sgm {
             return;
         }
 
-        std::vector<void*> properties;
-        script_engine::iterate_properties(_class, properties);
-
-        void* attribute_type = script_helpers::get_core_type("SGE.SectionHeaderAttribute", true);
-        void* header_names_property = script_engine::get_property(attribute_type, "HeaderNames");
+        const auto& properties = script_property_cache::get(_class);
 
         std::vector<section_header_t> headers;
-        for (void* property : properties) {
-            if (!script_helpers::is_property_serializable(property)) {
+        for (const auto& property : properties) {
+            if (!property.serializable) {
                 continue;
             }
 
-            std::vector<std::string> header_names;
-            if (script_helpers::property_has_attribute(property, attribute_type)) {
-                auto attribute = script_helpers::get_property_attribute(property, attribute_type);
-                void* object = attribute->get();
-
-                void* list = script_engine::get_property_value(object, header_names_property);
-                void* list_type = script_engine::get_class_from_object(list);
-
-                void* count_property = script_engine::get_property(list_type, "Count");
-                void* returned = script_engine::get_property_value(list, count_property);
-                int32_t count = script_engine::unbox_object<int32_t>(returned);
-
-                void* item_property = script_engine::get_property(list_type, "Item");
-                for (int32_t i = 0; i < count; i++) {
-                    returned = script_engine::get_property_value(list, item_property, &i);
-
-                    std::string name = script_engine::from_managed_string(returned);
-                    header_names.push_back(name);
-                }
-            } else {
-                header_names.push_back("");
-            }
-
             section_header_t* current_node = nullptr;
-            for (const auto& name : header_names) {
+            for (const auto& name : property.section_headers) {
                 std::vector<section_header_t>* nodes;
                 if (current_node != nullptr) {
                     nodes = &current_node->subheaders;
@@ -533,7 +518,7 @@ namespace sgm {
             }
 
             if (current_node != nullptr) {
-                current_node->properties.push_back(property);
+                current_node->properties.push_back(&property);
             }
         }
 
@@ -566,11 +551,9 @@ namespace sgm {
             indented = true;
         }
 
-        for (void* property : header.properties) {
-            std::string property_name = script_engine::get_property_name(property);
+        for (const auto* property : header.properties) {
             // todo: format label?
-
-            script_helpers::show_property_control(script_object, property, property_name);
+            script_helpers::show_property_control(script_object, *property, property->name);
         }
 
         for (const auto& subheader : header.subheaders) {
@@ -85,7 +85,7 @@ namespace sgm {
 
         struct section_header_t {
             std::string name;
-            std::vector<void*> properties;
+            std::vector<const script_property*> properties;
             std::vector<section_header_t> subheaders;
         };
 
@@ -38,6 +38,8 @@ namespace sgm {
 
         auto _scene = editor_scene::get_scene();
         ImGui::Checkbox("Render colliders", &_scene->colliders_rendered());
+        ImGui::Checkbox("Threaded physics", &_scene->physics_threaded());
+        ImGui::Checkbox("Batched script updates", &_scene->scripts_batched());
 
         if (ImGui::Button("Reload library shaders")) {
             m_reload_shaders = true;
@@ -52,6 +54,16 @@ namespace sgm {
             ImGui::Text("Indices: %u", stats.index_count);
         }
 
+        if (ImGui::CollapsingHeader("Garbage collector stats")) {
+            const auto& stats = garbage_collector::get_frame_stats();
+
+            ImGui::Text("Collection time: %f ms", stats.collection_time);
+            ImGui::Text("Nursery collections: %u", stats.nursery_collections);
+            ImGui::Text("Full collections: %u", stats.full_collections);
+            ImGui::Text("Heap size: %lld bytes", (long long)stats.heap_size);
+            ImGui::Text("Used: %lld bytes", (long long)stats.used_size);
+        }
+
         if (ImGui::CollapsingHeader("Device info")) {
             device_info info = renderer::query_device_info();
 
@@ -25,13 +25,10 @@ namespace sgm {
         size_t index = 0;
         _scene->for_each([&](entity current) {
             if (!current.has_all<tag_component>()) {
-                auto& tag = current.add_component<tag_component>();
-                tag.tag = "Entity";
+                current.add_component<tag_component>("Entity");
             }
 
-            std::string node_id = "entity-" + std::to_string(index);
-            ImGuiID id = ImGui::GetID(node_id.c_str());
-            ImGui::PushID(id);
+            ImGui::PushID((int32_t)index);
 
             bool selected = false;
             if (selection) {